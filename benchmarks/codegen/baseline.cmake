@@ -0,0 +1,32 @@
+# Generated by the codegen-baseline target (GCC, x86-64)
+set(probe_has_value_instructions_limit 3)
+set(probe_has_value_branches_limit 0)
+set(probe_value_or_instructions_limit 6)
+set(probe_value_or_branches_limit 1)
+set(probe_and_then_instructions_limit 18)
+set(probe_and_then_branches_limit 2)
+set(probe_map_instructions_limit 17)
+set(probe_map_branches_limit 2)
+set(probe_map_error_instructions_limit 18)
+set(probe_map_error_branches_limit 2)
+set(probe_or_else_instructions_limit 16)
+set(probe_or_else_branches_limit 2)
+set(probe_and_then_double_instructions_limit 14)
+set(probe_and_then_double_branches_limit 2)
+set(probe_map_niche_instructions_limit 10)
+set(probe_map_niche_branches_limit 1)
+set(probe_copy_instructions_limit 2)
+set(probe_copy_branches_limit 0)
+set(probe_forward_pointee_instructions_limit 6)
+set(probe_forward_pointee_branches_limit 1)
+set(probe_value_instructions_limit 8)
+set(probe_value_branches_limit 1)
+set(probe_expect_instructions_limit 10)
+set(probe_expect_branches_limit 1)
+set(probe_value_loop_instructions_limit 16)
+set(probe_value_loop_branches_limit 3)
+set(probe_chain_members_instructions_limit 45)
+set(probe_chain_members_branches_limit 6)
+set(probe_chain_pipeline_instructions_limit 42)
+set(probe_chain_pipeline_branches_limit 5)
+set(full_api_text_bytes_limit 13400)
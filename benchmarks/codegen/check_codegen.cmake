@@ -0,0 +1,152 @@
+# Checks the machine code of the probes in probes.cpp and the code size of
+# full_api.cpp against the limits recorded in baseline.cmake. Run in script
+# mode by the codegen-check and codegen-baseline targets:
+#
+#   cmake -DOBJDUMP=<objdump> -DPROBES_OBJECT=<probes.o>
+#         -DFULL_API_OBJECT=<full_api.o> -DEMPTY_OBJECT=<empty.o>
+#         -DBASELINE=<baseline.cmake> [-DTOLERANCE=<percent>] [-DUPDATE=ON]
+#         -P check_codegen.cmake
+#
+# A probe fails when it contains a call, other than to the outlined failure
+# paths fst::detail::throw_bad_result_access, or when its instruction count,
+# including the code the compiler split into a cold clone, exceeds the
+# baseline by more than TOLERANCE percent (default 10). Conditional branches
+# are counted the same way, and probe_chain_pipeline must have fewer
+# instructions and fewer conditional branches than probe_chain_members, the
+# pipeline exists to beat the member chain. The full API fails when its code
+# grows by more than TOLERANCE percent. With UPDATE the measured values are
+# written to BASELINE instead.
+#
+# The baseline and the call detection are specific to GCC on x86-64, the
+# targets are only defined there.
+
+foreach(variable OBJDUMP PROBES_OBJECT FULL_API_OBJECT EMPTY_OBJECT BASELINE)
+    if(NOT DEFINED ${variable})
+        message(FATAL_ERROR "check_codegen.cmake: ${variable} is not set")
+    endif()
+endforeach()
+
+if(NOT DEFINED TOLERANCE)
+    set(TOLERANCE 10)
+endif()
+
+# Runs objdump with the given arguments and returns its output as a list of
+# lines.
+function(objdump_lines out)
+    execute_process(
+        COMMAND ${OBJDUMP} ${ARGN}
+        OUTPUT_VARIABLE output
+        RESULT_VARIABLE status)
+    if(NOT status EQUAL 0)
+        message(FATAL_ERROR "objdump ${ARGN} failed")
+    endif()
+    string(REPLACE ";" "," output "${output}")
+    string(REPLACE "\n" ";" output "${output}")
+    set(${out} "${output}" PARENT_SCOPE)
+endfunction()
+
+# Sums the sizes of the .text sections of an object file, including the
+# per-function sections of inline functions.
+function(text_bytes object out)
+    objdump_lines(lines -h ${object})
+    set(total 0)
+    foreach(line IN LISTS lines)
+        if(line MATCHES "^ *[0-9]+ \\.text[^ ]* +([0-9a-f]+) ")
+            math(EXPR total "${total} + 0x${CMAKE_MATCH_1}")
+        endif()
+    endforeach()
+    set(${out} ${total} PARENT_SCOPE)
+endfunction()
+
+# Instruction, call and conditional branch counts of every probe function.
+objdump_lines(lines -d -r -C --no-show-raw-insn ${PROBES_OBJECT})
+set(probes)
+set(current)
+foreach(line IN LISTS lines)
+    if(line MATCHES "^[0-9a-f]+ <(probe_[a-z_]+)\\(.*>:$")
+        # Cold clones count towards the probe they were split from
+        set(current ${CMAKE_MATCH_1})
+        if(NOT line MATCHES "\\[clone ")
+            list(APPEND probes ${current})
+            set(${current}_instructions 0)
+            set(${current}_calls 0)
+            set(${current}_branches 0)
+        endif()
+    elseif(line MATCHES "^[0-9a-f]+ <")
+        set(current)
+    elseif(current AND line MATCHES "^ +[0-9a-f]+:\t(.*)$")
+        set(instruction "${CMAKE_MATCH_1}")
+        # Alignment padding between functions is not part of the probe
+        if(NOT instruction MATCHES "nop|^xchg +%ax,%ax")
+            math(EXPR ${current}_instructions "${${current}_instructions} + 1")
+        endif()
+        if(instruction MATCHES "^call")
+            math(EXPR ${current}_calls "${${current}_calls} + 1")
+        elseif(instruction MATCHES "^j" AND NOT instruction MATCHES "^jmp")
+            math(EXPR ${current}_branches "${${current}_branches} + 1")
+        endif()
+    elseif(current AND line MATCHES
+           "^\t+[0-9a-f]+: R_.*fst::detail::throw_bad_result_access\\(")
+        # The relocation of the preceding call names its target
+        math(EXPR ${current}_calls "${${current}_calls} - 1")
+    endif()
+endforeach()
+
+if(NOT probes)
+    message(FATAL_ERROR "No probe functions found in ${PROBES_OBJECT}")
+endif()
+
+text_bytes(${FULL_API_OBJECT} full_api_bytes)
+text_bytes(${EMPTY_OBJECT} empty_bytes)
+math(EXPR full_api_text_bytes "${full_api_bytes} - ${empty_bytes}")
+
+if(UPDATE)
+    set(content "# Generated by the codegen-baseline target (GCC, x86-64)\n")
+    foreach(probe IN LISTS probes)
+        string(APPEND content
+            "set(${probe}_instructions_limit ${${probe}_instructions})\n"
+            "set(${probe}_branches_limit ${${probe}_branches})\n")
+    endforeach()
+    string(APPEND content
+        "set(full_api_text_bytes_limit ${full_api_text_bytes})\n")
+    file(WRITE ${BASELINE} "${content}")
+    message(STATUS "Wrote ${BASELINE}")
+    return()
+endif()
+
+include(${BASELINE})
+
+# Fails when `measured` exceeds `limit` by more than TOLERANCE percent.
+function(check name measured limit)
+    if(NOT DEFINED limit OR limit STREQUAL "")
+        message(SEND_ERROR "${name}: no baseline, run codegen-baseline")
+        return()
+    endif()
+    math(EXPR allowed "${limit} + ${limit} * ${TOLERANCE} / 100")
+    if(measured GREATER allowed)
+        message(SEND_ERROR "${name}: ${measured}, baseline ${limit}")
+    else()
+        message(STATUS "${name}: ${measured} (baseline ${limit})")
+    endif()
+endfunction()
+
+foreach(probe IN LISTS probes)
+    if(${probe}_calls GREATER 0)
+        message(SEND_ERROR "${probe}: contains ${${probe}_calls} call(s)")
+    endif()
+    check("${probe} instructions" ${${probe}_instructions}
+          "${${probe}_instructions_limit}")
+    check("${probe} branches" ${${probe}_branches}
+          "${${probe}_branches_limit}")
+endforeach()
+
+foreach(kind instructions branches)
+    if(NOT probe_chain_pipeline_${kind} LESS probe_chain_members_${kind})
+        message(SEND_ERROR "probe_chain_pipeline: "
+            "${probe_chain_pipeline_${kind}} ${kind}, not fewer than the "
+            "member chain's ${probe_chain_members_${kind}}")
+    endif()
+endforeach()
+
+check("full API .text bytes" ${full_api_text_bytes}
+      "${full_api_text_bytes_limit}")
@@ -0,0 +1,6 @@
+// Includes result without instantiating it, the reference for the code size
+// of full_api.cpp.
+
+#include <string>
+
+#include "fst/result.hpp"
@@ -0,0 +1,43 @@
+// Instantiates the whole result API for a few payload types, the size of its
+// code relative to empty.cpp is checked by check_codegen.cmake.
+
+#include <string>
+
+#include "fst/result.hpp"
+
+template class fst::result<int, std::string>;
+template class fst::result<double, int>;
+template class fst::result<std::string, std::string>;
+template class fst::result<void, std::string>;
+template class fst::result<int&, std::string>;
+
+namespace {
+
+template <typename R>
+void combinators(R& r) {
+  using T = typename R::value_type;
+  using E = typename R::error_type;
+  auto same = [](const auto& x) { return R(fst::success_t, x); };
+  auto recover = [](const auto&) { return R(); };
+  auto keep = [](const T& x) { return x; };
+  auto keep_error = [](const E& e) { return e; };
+  auto whole = [](const R& x) { return x; };
+
+  R results[] = {r.and_then(same), R(r).and_then(same),
+                 r.or_else(recover), R(r).or_else(recover),
+                 r.map(keep),        R(r).map(keep),
+                 r.map_error(keep_error), R(r).map_error(keep_error),
+                 r.transform(whole), R(r).transform(whole),
+                 r.inspect([](const R&) {})};
+  for (R& result : results) r = std::move(result);
+}
+
+}  // namespace
+
+void instantiate_full_api(fst::result<int, std::string>& a,
+                          fst::result<double, int>& b,
+                          fst::result<std::string, std::string>& c) {
+  combinators(a);
+  combinators(b);
+  combinators(c);
+}
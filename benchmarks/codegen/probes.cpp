@@ -0,0 +1,205 @@
+// Probe functions whose machine code is checked by check_codegen.cmake, and
+// the layout of result for a matrix of payload types, checked at compile
+// time. Each probe is a non-inline function of a single operation on
+// trivially copyable payloads, which should compile to a state test and a
+// return without any call. The checked accesses may only call the outlined
+// fst::detail::throw_bad_result_access on their failure path.
+// probe_chain_* compare a member chain with the same fused pipeline.
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "fst/error_code.hpp"
+#include "fst/error_string.hpp"
+#include "fst/pipeline.hpp"
+#include "fst/result.hpp"
+
+namespace {
+
+enum class color : unsigned char { red, green, blue };
+
+template <typename X>
+constexpr std::size_t size_of() {
+  if constexpr (std::is_void_v<X>)
+    return 0;
+  else if constexpr (std::is_reference_v<X>)
+    return sizeof(void*);
+  else
+    return sizeof(X);
+}
+
+template <typename X>
+constexpr std::size_t align_of() {
+  if constexpr (std::is_void_v<X>)
+    return 1;
+  else if constexpr (std::is_reference_v<X>)
+    return alignof(void*);
+  else
+    return alignof(X);
+}
+
+// Size of a result storing its state in a separate byte after the payload.
+template <typename T, typename E>
+constexpr std::size_t tagged_size() {
+  constexpr std::size_t payload =
+      size_of<T>() > size_of<E>() ? size_of<T>() : size_of<E>();
+  constexpr std::size_t align =
+      align_of<T>() > align_of<E>() ? align_of<T>() : align_of<E>();
+  return (payload + 1 + align - 1) / align * align;
+}
+
+template <typename T, typename E>
+constexpr bool tagged_layout() {
+  return sizeof(fst::result<T, E>) == tagged_size<T, E>() &&
+         alignof(fst::result<T, E>) ==
+             (align_of<T>() > align_of<E>() ? align_of<T>() : align_of<E>());
+}
+
+}  // namespace
+
+template <>
+struct fst::niche_traits<color> : fst::enum_niche_traits<color, color::blue> {};
+
+// Tagged layouts: the payload, one state byte and the padding it requires.
+static_assert(tagged_layout<char, unsigned char>());
+static_assert(tagged_layout<int, unsigned>());
+static_assert(tagged_layout<int, long>());
+static_assert(tagged_layout<double, int>());
+static_assert(tagged_layout<int, fst::error_code>());
+static_assert(tagged_layout<int, fst::error_string>());
+static_assert(tagged_layout<std::string, int>());
+static_assert(tagged_layout<std::string, std::string>());
+static_assert(tagged_layout<void, int>());
+static_assert(tagged_layout<void, fst::error_code>());
+static_assert(tagged_layout<int&, int>());
+static_assert(tagged_layout<int&, fst::error_code>());
+
+// Niche layouts: the state lives in spare bits, no larger than the payload.
+static_assert(sizeof(fst::result<long*, int*>) == sizeof(long*));
+static_assert(sizeof(fst::result<color, bool>) == sizeof(color));
+
+// A pointer to a forward-declared type paired with a payload without spare
+// bits is tagged, and stays tagged once the type is complete. Pairing it with
+// another pointer requires both pointees to be complete.
+struct forward_pointee;
+static_assert(tagged_layout<forward_pointee*, long>());
+struct forward_pointee {
+  long value;
+};
+struct forward_error {
+  int code;
+};
+static_assert(tagged_layout<forward_pointee*, long>());
+static_assert(sizeof(fst::result<forward_pointee*, forward_error*>) ==
+              sizeof(forward_pointee*));
+
+// Trivially copyable payloads keep result trivially copyable.
+static_assert(std::is_trivially_copyable_v<fst::result<int, int*>>);
+static_assert(std::is_trivially_copyable_v<fst::result<double, int>>);
+static_assert(std::is_trivially_copyable_v<fst::result<void, int>>);
+
+using int_result = fst::result<int, unsigned>;
+using double_result = fst::result<double, int>;
+using pointer_result = fst::result<long*, int*>;
+
+bool probe_has_value(const int_result& r) { return r.has_value(); }
+
+int probe_value_or(const int_result& r) { return r.value_or(-1); }
+
+int_result probe_and_then(const int_result& r) {
+  return r.and_then([](int x) { return int_result(fst::success_t, x + 1); });
+}
+
+int_result probe_map(const int_result& r) {
+  return r.map([](int x) { return x * 2; });
+}
+
+int_result probe_map_error(const int_result& r) {
+  return r.map_error([](unsigned e) { return e + 1; });
+}
+
+int_result probe_or_else(const int_result& r) {
+  return r.or_else([](unsigned) { return int_result(fst::success_t, -1); });
+}
+
+double_result probe_and_then_double(const double_result& r) {
+  return r.and_then(
+      [](double x) { return double_result(fst::success_t, x * 0.5); });
+}
+
+pointer_result probe_map_niche(const pointer_result& r) {
+  return r.map([](long* p) { return p + 1; });
+}
+
+int_result probe_copy(const int_result& r) { return r; }
+
+long probe_forward_pointee(
+    const fst::result<forward_pointee*, forward_error*>& r) {
+  return r.has_value() ? (*r)->value : -1;
+}
+
+int probe_value(const int_result& r) { return r.value(); }
+
+int probe_expect(const int_result& r) { return r.expect("probe"); }
+
+// A checked access in a loop, the loop must keep only the test and the call
+// of the outlined failure path.
+long probe_value_loop(const int_result* first, const int_result* last) {
+  long sum = 0;
+  for (; first != last; ++first) sum += first->value();
+  return sum;
+}
+
+namespace {
+
+struct halve_fn {
+  int_result operator()(int x) const {
+    return x % 2 ? int_result(fst::error_t, 1u)
+                 : int_result(fst::success_t, x / 2);
+  }
+};
+
+struct increment_fn {
+  int operator()(int x) const { return x + 1; }
+};
+
+struct scale_error_fn {
+  unsigned operator()(unsigned e) const { return e * 3; }
+};
+
+struct recover_fn {
+  int_result operator()(unsigned e) const {
+    return e > 5 ? int_result(fst::error_t, e) : int_result(fst::success_t, 0);
+  }
+};
+
+constexpr halve_fn halve{};
+constexpr increment_fn increment{};
+constexpr scale_error_fn scale_error{};
+constexpr recover_fn recover{};
+
+const auto chain = fst::pipe | fst::and_then(halve) | fst::map(increment) |
+                   fst::map_error(scale_error) | fst::and_then(halve) |
+                   fst::or_else(recover) | fst::map(increment) |
+                   fst::and_then(halve) | fst::map_error(scale_error) |
+                   fst::map(increment);
+
+}  // namespace
+
+// The same chain of every stage kind as member calls and as a fused
+// pipeline. check_codegen.cmake requires the pipeline to have fewer
+// instructions and fewer conditional branches than the member chain.
+int_result probe_chain_members(const int_result& r) {
+  return r.and_then(halve)
+      .map(increment)
+      .map_error(scale_error)
+      .and_then(halve)
+      .or_else(recover)
+      .map(increment)
+      .and_then(halve)
+      .map_error(scale_error)
+      .map(increment);
+}
+
+int_result probe_chain_pipeline(const int_result& r) { return chain(r); }
@@ -0,0 +1,120 @@
+// Measures checked accesses in tight loops. value() and expect() test the
+// state inline and call an outlined cold function on failure, the baseline
+// constructs and throws bad_result_access at the call site like the accessors
+// did before, and value_or() is the unchecked reference.
+//
+// Every input is a success, so the failure paths only cost code size: compare
+// the loops with `objdump -d` (or `perf stat -e L1-icache-load-misses`), the
+// probes of the codegen-check target pin the instruction counts.
+//
+// Build with optimisations, e.g. -DCMAKE_BUILD_TYPE=Release, for meaningful
+// numbers.
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+#include "fst/result.hpp"
+
+#if defined(__GNUC__) || defined(__clang__)
+#define BENCH_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define BENCH_NOINLINE __declspec(noinline)
+#else
+#define BENCH_NOINLINE
+#endif
+
+namespace {
+
+using int_result = fst::result<int, unsigned>;
+
+BENCH_NOINLINE long sum_value_or(const std::vector<int_result>& results) {
+  long sum = 0;
+  for (const auto& r : results) sum += r.value_or(0);
+  return sum;
+}
+
+BENCH_NOINLINE long sum_value(const std::vector<int_result>& results) {
+  long sum = 0;
+  for (const auto& r : results) sum += r.value();
+  return sum;
+}
+
+BENCH_NOINLINE long sum_expect(const std::vector<int_result>& results) {
+  long sum = 0;
+  for (const auto& r : results) sum += r.expect("inputs are valid");
+  return sum;
+}
+
+#if !defined(FST_NO_EXCEPTIONS)
+BENCH_NOINLINE long sum_inline_throw(const std::vector<int_result>& results) {
+  long sum = 0;
+  for (const auto& r : results) {
+    if (!r.has_value())
+      throw fst::bad_result_access(r.state(), "inputs are valid");
+    sum += r.value_or(0);
+  }
+  return sum;
+}
+#endif
+
+// Sixteen checked accesses per iteration, each one a separate call site with
+// its own failure path.
+BENCH_NOINLINE long sum_unrolled(const std::vector<int_result>& results) {
+  long sum = 0;
+  for (std::size_t i = 0; i + 16 <= results.size(); i += 16) {
+    const int_result* r = &results[i];
+    sum += r[0].expect("0") + r[1].expect("1") + r[2].expect("2") +
+           r[3].expect("3") + r[4].expect("4") + r[5].expect("5") +
+           r[6].expect("6") + r[7].expect("7") + r[8].expect("8") +
+           r[9].expect("9") + r[10].expect("10") + r[11].expect("11") +
+           r[12].expect("12") + r[13].expect("13") + r[14].expect("14") +
+           r[15].expect("15");
+  }
+  return sum;
+}
+
+// Prints the best of five timings of `rounds` calls of f.
+template <typename F>
+void run(const char* name, const std::vector<int_result>& results, F f) {
+  constexpr int repeats = 5;
+  constexpr int rounds = 2000;
+  double best = 0;
+  long long checksum = 0;
+
+  for (int repeat = 0; repeat < repeats; ++repeat) {
+    checksum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; ++round) checksum += f(results);
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    const double ns =
+        std::chrono::duration<double, std::nano>(elapsed).count() /
+        (static_cast<double>(results.size()) * rounds);
+    best = repeat == 0 ? ns : std::min(best, ns);
+  }
+
+  std::cout << name << ": " << best << " ns/access (checksum " << checksum
+            << ")\n";
+}
+
+}  // namespace
+
+int main() {
+  std::vector<int_result> results;
+  results.reserve(1 << 14);
+  for (int i = 0; i < (1 << 14); ++i)
+    results.emplace_back(fst::success_t, i & 0xFF);
+
+  run("value_or (unchecked)", results, sum_value_or);
+  run("value", results, sum_value);
+  run("expect", results, sum_expect);
+#if !defined(FST_NO_EXCEPTIONS)
+  run("throw at call site", results, sum_inline_throw);
+#endif
+  run("expect, 16 call sites", results, sum_unrolled);
+
+  return 0;
+}
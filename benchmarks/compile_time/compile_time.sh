@@ -0,0 +1,79 @@
+#!/bin/sh
+# Measures what including each result header costs a translation unit: the
+# size of the preprocessed output, the preprocessing time and the time to
+# compile a TU that includes the header and uses a result.
+#
+#   compile_time.sh [compiler] [runs] [baseline-ref]
+#
+# The first row is fst/result.hpp as of the git revision `baseline-ref`
+# (default HEAD~), extracted from git with the rest of its include
+# directory; it is skipped outside a git checkout or when the revision has no
+# such file. Pass the commit before the split into fst/result_core.hpp (no
+# iostreams), fst/result_io.hpp and fst/result_fwd.hpp to measure what the
+# split saves. fst/result.hpp is today's umbrella header including all of
+# them. The best of `runs` (default 10) is reported in milliseconds.
+
+set -eu
+
+compiler=${1:-${CXX:-c++}}
+runs=${2:-10}
+baseline_ref=${3:-HEAD~}
+root=$(cd "$(dirname "$0")/../.." && pwd)
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+
+mkdir -p "$work/baseline"
+headers="result.hpp result_core.hpp result_fwd.hpp"
+if git -C "$root" archive "$baseline_ref" include 2> /dev/null |
+    tar -x -C "$work/baseline" 2> /dev/null &&
+    [ -f "$work/baseline/include/fst/result.hpp" ]; then
+  headers="baseline $headers"
+fi
+
+now_ms() {
+  echo $(($(date +%s%N) / 1000000))
+}
+
+# Best wall time of `runs` executions of the given command, in milliseconds.
+best_ms() {
+  best=
+  i=0
+  while [ "$i" -lt "$runs" ]; do
+    start=$(now_ms)
+    "$@" > /dev/null
+    elapsed=$(($(now_ms) - start))
+    if [ -z "$best" ] || [ "$elapsed" -lt "$best" ]; then
+      best=$elapsed
+    fi
+    i=$((i + 1))
+  done
+  echo "$best"
+}
+
+printf '%-22s %12s %16s %13s\n' header preprocessed preprocess_ms compile_ms
+for header in $headers; do
+  include=$root/include
+  name=fst/$header
+  if [ "$header" = baseline ]; then
+    include=$work/baseline/include
+    name="baseline ($baseline_ref)"
+    header=result.hpp
+  fi
+
+  tu="$work/${header%.hpp}.cpp"
+  if [ "$header" = result_fwd.hpp ]; then
+    printf '#include "fst/%s"\nint use(const fst::result<int, int>&);\n' \
+      "$header" > "$tu"
+  else
+    printf '#include "fst/%s"\nint use(const fst::result<int, int>& r) {\n' \
+      "$header" > "$tu"
+    printf '  return r.value_or(0);\n}\n' >> "$tu"
+  fi
+
+  flags="-std=c++17 -I$include"
+  lines=$($compiler $flags -E "$tu" | wc -l)
+  preprocess=$(best_ms $compiler $flags -E "$tu")
+  compile=$(best_ms $compiler $flags -c "$tu" -o "$work/tu.o")
+  printf '%-22s %12s %16s %13s\n' "$name" "$lines" "$preprocess" \
+    "$compile"
+done
@@ -0,0 +1,86 @@
+// Compares three ways of propagating errors through a chain of fallible
+// steps: hand-written if checks, and_then chains and co_await.
+//
+// Build with optimisations, e.g. -DCMAKE_BUILD_TYPE=Release, for meaningful
+// numbers.
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+#include "fst/result.hpp"
+#include "fst/result_coroutine.hpp"
+
+namespace {
+
+using int_result = fst::result<int, int>;
+
+// Step that fails for inputs divisible by `modulus`, opaque to the optimiser
+// through the input data.
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((noinline))
+#endif
+int_result
+step(int x, int modulus) {
+  if (x % modulus == 0) return int_result(fst::error_t, x);
+  return int_result(fst::success_t, x + 1);
+}
+
+int_result chain_if(int x) {
+  auto a = step(x, 101);
+  if (!a) return a;
+  auto b = step(*a, 103);
+  if (!b) return b;
+  auto c = step(*b, 107);
+  if (!c) return c;
+  return int_result(fst::success_t, *c * 2);
+}
+
+int_result chain_and_then(int x) {
+  return step(x, 101)
+      .and_then([](int a) { return step(a, 103); })
+      .and_then([](int b) { return step(b, 107); })
+      .map([](int c) { return c * 2; });
+}
+
+int_result chain_co_await(int x) {
+  int a = co_await step(x, 101);
+  int b = co_await step(a, 103);
+  int c = co_await step(b, 107);
+  co_return int_result(fst::success_t, c * 2);
+}
+
+template <typename F>
+void run(const char* name, const std::vector<int>& inputs, F f) {
+  constexpr int rounds = 20;
+  long long checksum = 0;
+
+  const auto start = std::chrono::steady_clock::now();
+  for (int round = 0; round < rounds; ++round)
+    for (int x : inputs) {
+      const int_result r = f(x);
+      checksum += r.has_value() ? *r : -*r.error();
+    }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+
+  const double ns =
+      std::chrono::duration<double, std::nano>(elapsed).count() /
+      (static_cast<double>(inputs.size()) * rounds);
+  std::cout << name << ": " << ns << " ns/call (checksum " << checksum
+            << ")\n";
+}
+
+}  // namespace
+
+int main() {
+  std::vector<int> inputs(1 << 20);
+  for (std::size_t i = 0; i < inputs.size(); ++i)
+    inputs[i] = static_cast<int>(i);
+
+  run("if checks", inputs, chain_if);
+  run("and_then", inputs, chain_and_then);
+  run("co_await", inputs, chain_co_await);
+
+  return 0;
+}
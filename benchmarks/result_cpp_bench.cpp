@@ -0,0 +1,354 @@
+// Compares fst::result with other ways of reporting failures: exceptions
+// (unless they are disabled), error codes with an out parameter,
+// std::optional, std::variant and, when the standard library provides it,
+// std::expected.
+//
+// Every strategy runs the same call chain: a leaf fails for a fraction of the
+// inputs, each of `depth` levels above it propagates the failure or updates
+// the payload. The sweep covers error rates, call depths and payload sizes
+// and prints one record per configuration as CSV (default) or JSON:
+//
+//   result-cpp-bench [--format csv|json] [--calls N] [--repeats N]
+//
+// Build with optimisations, e.g. -DCMAKE_BUILD_TYPE=Release, for meaningful
+// numbers.
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#if __has_include(<expected>)
+#include <expected>
+#endif
+
+#include "fst/result.hpp"
+
+#if defined(__GNUC__) || defined(__clang__)
+#define BENCH_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define BENCH_NOINLINE __declspec(noinline)
+#else
+#define BENCH_NOINLINE
+#endif
+
+namespace {
+
+template <std::size_t N>
+struct payload {
+  unsigned char bytes[N];
+};
+
+template <std::size_t N>
+payload<N> make_payload(int x) {
+  payload<N> p;
+  for (std::size_t i = 0; i < N; ++i)
+    p.bytes[i] = static_cast<unsigned char>(x + static_cast<int>(i));
+  return p;
+}
+
+// Work done by every level on success.
+template <std::size_t N>
+void touch(payload<N>& p) {
+  ++p.bytes[0];
+  ++p.bytes[N - 1];
+}
+
+struct bench_error : std::exception {
+  explicit bench_error(int code) noexcept : code(code) {}
+  const char* what() const noexcept override { return "bench_error"; }
+  int code;
+};
+
+struct result_strategy {
+  static constexpr std::string_view name = "result";
+
+  template <std::size_t N>
+  using type = fst::result<payload<N>, int>;
+
+  template <std::size_t N>
+  BENCH_NOINLINE static type<N> call(int depth, int x, bool fail) {
+    if (depth == 0)
+      return fail ? type<N>(fst::error_t, x)
+                  : type<N>(fst::success_t, make_payload<N>(x));
+    auto r = call<N>(depth - 1, x, fail);
+    if (!r) return r;
+    touch(*r);
+    return r;
+  }
+
+  template <std::size_t N>
+  static long run(int depth, int x, bool fail) {
+    const auto r = call<N>(depth, x, fail);
+    return r ? (*r).bytes[0] : -*r.error();
+  }
+};
+
+// Not available when exceptions are disabled, see FST_NO_EXCEPTIONS.
+#if !defined(FST_NO_EXCEPTIONS)
+struct exception_strategy {
+  static constexpr std::string_view name = "exceptions";
+
+  template <std::size_t N>
+  BENCH_NOINLINE static payload<N> call(int depth, int x, bool fail) {
+    if (depth == 0) {
+      if (fail) throw bench_error(x);
+      return make_payload<N>(x);
+    }
+    auto p = call<N>(depth - 1, x, fail);
+    touch(p);
+    return p;
+  }
+
+  template <std::size_t N>
+  static long run(int depth, int x, bool fail) {
+    try {
+      return call<N>(depth, x, fail).bytes[0];
+    } catch (const bench_error& e) {
+      return -e.code;
+    }
+  }
+};
+#endif
+
+struct error_code_strategy {
+  static constexpr std::string_view name = "error_code";
+
+  template <std::size_t N>
+  BENCH_NOINLINE static int call(int depth, int x, bool fail,
+                                 payload<N>& out) {
+    if (depth == 0) {
+      if (fail) return x;
+      out = make_payload<N>(x);
+      return 0;
+    }
+    if (const int code = call<N>(depth - 1, x, fail, out)) return code;
+    touch(out);
+    return 0;
+  }
+
+  template <std::size_t N>
+  static long run(int depth, int x, bool fail) {
+    payload<N> p;
+    const int code = call<N>(depth, x, fail, p);
+    return code == 0 ? p.bytes[0] : -code;
+  }
+};
+
+// std::optional cannot carry the error, the failing input is reported
+// instead so that the checksum matches the other strategies.
+struct optional_strategy {
+  static constexpr std::string_view name = "optional";
+
+  template <std::size_t N>
+  BENCH_NOINLINE static std::optional<payload<N>> call(int depth, int x,
+                                                       bool fail) {
+    if (depth == 0)
+      return fail ? std::nullopt
+                  : std::optional<payload<N>>(make_payload<N>(x));
+    auto r = call<N>(depth - 1, x, fail);
+    if (!r) return r;
+    touch(*r);
+    return r;
+  }
+
+  template <std::size_t N>
+  static long run(int depth, int x, bool fail) {
+    const auto r = call<N>(depth, x, fail);
+    return r ? r->bytes[0] : -x;
+  }
+};
+
+struct variant_strategy {
+  static constexpr std::string_view name = "variant";
+
+  template <std::size_t N>
+  using type = std::variant<payload<N>, int>;
+
+  template <std::size_t N>
+  BENCH_NOINLINE static type<N> call(int depth, int x, bool fail) {
+    if (depth == 0)
+      return fail ? type<N>(std::in_place_index<1>, x)
+                  : type<N>(std::in_place_index<0>, make_payload<N>(x));
+    auto r = call<N>(depth - 1, x, fail);
+    if (r.index() != 0) return r;
+    touch(*std::get_if<0>(&r));
+    return r;
+  }
+
+  template <std::size_t N>
+  static long run(int depth, int x, bool fail) {
+    const auto r = call<N>(depth, x, fail);
+    return r.index() == 0 ? std::get_if<0>(&r)->bytes[0]
+                          : -*std::get_if<1>(&r);
+  }
+};
+
+#if defined(__cpp_lib_expected)
+struct expected_strategy {
+  static constexpr std::string_view name = "expected";
+
+  template <std::size_t N>
+  using type = std::expected<payload<N>, int>;
+
+  template <std::size_t N>
+  BENCH_NOINLINE static type<N> call(int depth, int x, bool fail) {
+    if (depth == 0)
+      return fail ? type<N>(std::unexpect, x) : type<N>(make_payload<N>(x));
+    auto r = call<N>(depth - 1, x, fail);
+    if (!r) return r;
+    touch(*r);
+    return r;
+  }
+
+  template <std::size_t N>
+  static long run(int depth, int x, bool fail) {
+    const auto r = call<N>(depth, x, fail);
+    return r ? r->bytes[0] : -r.error();
+  }
+};
+#endif
+
+struct options {
+  bool json = false;
+  std::size_t calls = 1 << 16;
+  int repeats = 3;
+};
+
+struct record {
+  std::string_view strategy;
+  std::size_t payload_bytes;
+  int depth;
+  int error_percent;
+  double ns_per_call;
+  long long checksum;
+};
+
+// Failure flags with the given rate in a pseudo-random order, identical for
+// every strategy so that they see the same branch pattern.
+std::vector<unsigned char> make_failures(std::size_t count,
+                                         int error_percent) {
+  std::vector<unsigned char> failures(count);
+  std::uint32_t state = 12345;
+  for (auto& failure : failures) {
+    state = state * 1664525u + 1013904223u;
+    failure = static_cast<int>((state >> 8) % 100) < error_percent;
+  }
+  return failures;
+}
+
+template <typename Strategy, std::size_t N>
+record measure(const options& opts, int depth, int error_percent,
+               const std::vector<unsigned char>& failures) {
+  double best = 0;
+  long long checksum = 0;
+  for (int repeat = 0; repeat < opts.repeats; ++repeat) {
+    checksum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < failures.size(); ++i)
+      checksum += Strategy::template run<N>(
+          depth, static_cast<int>(i & 0xFF) + 1, failures[i] != 0);
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    const double ns =
+        std::chrono::duration<double, std::nano>(elapsed).count() /
+        static_cast<double>(failures.size());
+    best = repeat == 0 ? ns : std::min(best, ns);
+  }
+  return {Strategy::name, N, depth, error_percent, best, checksum};
+}
+
+void print(const options& opts, const record& r, bool first) {
+  if (opts.json) {
+    std::cout << (first ? "[\n" : ",\n") << "  {\"strategy\": \"" << r.strategy
+              << "\", \"payload_bytes\": " << r.payload_bytes
+              << ", \"depth\": " << r.depth
+              << ", \"error_rate\": " << r.error_percent / 100.0
+              << ", \"ns_per_call\": " << r.ns_per_call
+              << ", \"checksum\": " << r.checksum << '}';
+  } else {
+    if (first)
+      std::cout << "strategy,payload_bytes,depth,error_rate,ns_per_call,"
+                   "checksum\n";
+    std::cout << r.strategy << ',' << r.payload_bytes << ',' << r.depth << ','
+              << r.error_percent / 100.0 << ',' << r.ns_per_call << ','
+              << r.checksum << '\n';
+  }
+}
+
+template <std::size_t N, typename... Strategies>
+void sweep_strategies(const options& opts, int depth, int error_percent,
+                      const std::vector<unsigned char>& failures,
+                      bool& first) {
+  ((print(opts,
+          measure<Strategies, N>(opts, depth, error_percent, failures),
+          first),
+    first = false),
+   ...);
+}
+
+template <std::size_t... Ns>
+void sweep(const options& opts, std::index_sequence<Ns...>) {
+  constexpr int depths[] = {1, 4, 16};
+  constexpr int error_percents[] = {0, 1, 10, 50, 100};
+
+  bool first = true;
+  for (const int error_percent : error_percents) {
+    const auto failures = make_failures(opts.calls, error_percent);
+    for (const int depth : depths)
+      (sweep_strategies<Ns, result_strategy,
+#if !defined(FST_NO_EXCEPTIONS)
+                        exception_strategy,
+#endif
+                        error_code_strategy, optional_strategy,
+#if defined(__cpp_lib_expected)
+                        expected_strategy,
+#endif
+                        variant_strategy>(opts, depth, error_percent,
+                                          failures, first),
+       ...);
+  }
+  if (opts.json) std::cout << "\n]\n";
+}
+
+bool parse_options(int argc, char** argv, options& opts) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (arg == "--format" && has_value) {
+      const std::string_view format = argv[++i];
+      if (format != "csv" && format != "json") return false;
+      opts.json = format == "json";
+    } else if (arg == "--calls" && has_value) {
+      opts.calls = std::strtoul(argv[++i], nullptr, 10);
+      if (opts.calls == 0) return false;
+    } else if (arg == "--repeats" && has_value) {
+      opts.repeats = std::atoi(argv[++i]);
+      if (opts.repeats <= 0) return false;
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  options opts;
+  if (!parse_options(argc, argv, opts)) {
+    std::cerr << "usage: " << argv[0]
+              << " [--format csv|json] [--calls N] [--repeats N]\n";
+    return 2;
+  }
+
+  sweep(opts, std::index_sequence<8, 64, 256>());
+  return 0;
+}
@@ -0,0 +1,82 @@
+#include <iostream>
+#include <string>
+#include <thread>
+#include <tuple>
+
+#include "fst/async_result.hpp"
+#include "fst/pipeline.hpp"
+#include "fst/result.hpp"
+
+// Stage run on the pool that fails for negative inputs
+fst::result<int, std::string> fetch(int id) {
+  if (id < 0) return std::string("No record with id " + std::to_string(id));
+  return id * 10;
+}
+
+int main() {
+  fst::thread_pool pool(4);
+
+  // Example 1: Build a chain up front, the continuations run on the pool
+  // thread that completes the fetch, nothing blocks until get()
+  auto chained =
+      fst::async(pool, [] { return fetch(4); })
+          .map([](int x) { return x + 2; })
+          .and_then([](int x) -> fst::result<std::string, std::string> {
+            return {fst::success_t, "record " + std::to_string(x)};
+          });
+  std::cout << "Chained: " << std::move(chained).get() << '\n';
+
+  // The same chain passed as a pipeline runs inside the task, one state is
+  // allocated for the whole chain instead of one per stage
+  auto fused = fst::async(
+      pool, [] { return fetch(4); },
+      fst::pipe | fst::map([](int x) { return x + 2; }) |
+          fst::and_then([](int x) -> fst::result<std::string, std::string> {
+            return {fst::success_t, "record " + std::to_string(x)};
+          }));
+  std::cout << "Fused: " << std::move(fused).get() << '\n';
+
+  // Example 2: Errors flow through the chain like with result, or_else
+  // recovers from them
+  auto recovered = fst::async(pool, [] { return fetch(-1); })
+                       .map([](int x) { return x + 2; })
+                       .or_else([](const std::string& e) {
+                         std::cout << "Recovering from: " << e << '\n';
+                         return fst::result<int, std::string>(0);
+                       });
+  auto value = std::move(recovered).get();
+  std::cout << "Recovered: " << value << '\n';
+
+  // Example 3: A promise completes a result from any thread
+  fst::async_promise<int, std::string> promise;
+  auto pending = promise.get_async_result().map([](int x) { return x * 2; });
+  std::thread producer(
+      [&promise] { promise.set(fst::result<int, std::string>(21)); });
+  std::cout << "From promise: " << std::move(pending).get() << '\n';
+  producer.join();
+
+  // A consumed handle is not ready, a promise hands out its result only once
+  std::cout << std::boolalpha << "Consumed handle ready: "
+            << pending.is_ready() << ", second result empty: "
+            << std::move(promise.get_async_result()).get().is_empty() << '\n';
+
+  // Example 4: when_all combines the values, or forwards the first error
+  // without waiting for the remaining inputs
+  auto both = fst::when_all(fst::async(pool, [] { return fetch(1); }),
+                            fst::async(pool, [] { return fetch(2); }));
+  auto [a, b] = std::move(both).get().value();
+  std::cout << "All: " << a << ", " << b << '\n';
+
+  fst::async_promise<int, std::string> never_set_yet;
+  auto failed = fst::when_all(never_set_yet.get_async_result(),
+                              fst::async(pool, [] { return fetch(-3); }));
+  std::cout << "All failed: " << *std::move(failed).get().error() << '\n';
+
+  // Example 5: when_any completes with whichever input finishes first
+  auto first = fst::when_any(
+      fst::async_result<int, std::string>(fst::result<int, std::string>(7)),
+      fst::async(pool, [] { return fetch(3); }));
+  std::cout << "Any: " << std::move(first).get() << '\n';
+
+  return 0;
+}
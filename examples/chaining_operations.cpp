@@ -1,6 +1,7 @@
 #include <iostream>
 #include <limits>
 
+#include "fst/error_message.hpp"
 #include "fst/result.hpp"
 
 // Function that may fail and return a Result
@@ -10,6 +11,13 @@ fst::result<double, std::string> div(double a, double b) {
   return a / b;  // Implicitly converts to double
 }
 
+// Same as div, but the error message is only formatted when it is streamed
+fst::result<double, fst::error_message> lazy_div(double a, double b) {
+  if (b == 0.0)
+    return fst::error_message("Division of {} by zero error", a);
+  return a / b;
+}
+
 int main() {
 // Example 1: Chaining with `and_then` and `map`
 auto result1 = div(12.0, 3.0)
@@ -25,14 +33,15 @@ auto result1 = div(12.0, 3.0)
 
 std::cout << "Example 1: " << result1 << '\n';
 
-// Example 2: Chaining with `or_else` and `map_error`
-auto result2 = div(10.0, 0.0)
-                    .or_else([](const auto& error) {
-                      return fst::result<double, std::string>("Error: " + error);
+// Example 2: Chaining with `or_else` and `map_error`, the context is captured
+// without formatting and rendered in front of the error when streamed
+auto result2 = lazy_div(10.0, 0.0)
+                    .or_else([](const fst::error_message& error) {
+                      return fst::result<double, fst::error_message>(
+                          fst::error_t,
+                          fst::error_message(error).with_context("Error"));
                     })
-                    .map_error([](const std::string& original_error) {
-                      return original_error + " (mapped)";
-                    });
+                    .map_error(fst::context("mapped from {}", "lazy_div"));
 
 std::cout << "Example 2: " << result2 << '\n';
 
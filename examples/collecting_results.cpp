@@ -0,0 +1,61 @@
+#include <charconv>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "fst/algorithm.hpp"
+#include "fst/error_io.hpp"
+#include "fst/result.hpp"
+
+// Parses a single field of a batch
+fst::result<int, std::string> parse_field(const std::string& field) {
+  int value = 0;
+  const char* end = field.data() + field.size();
+  const auto parsed = std::from_chars(field.data(), end, value);
+  if (parsed.ec != std::errc() || parsed.ptr != end)
+    return std::string("Not a number: " + field);
+  return value;
+}
+
+std::vector<fst::result<int, std::string>> parse_batch(
+    const std::vector<std::string>& fields) {
+  std::vector<fst::result<int, std::string>> parsed;
+  parsed.reserve(fields.size());
+  for (const auto& field : fields) parsed.push_back(parse_field(field));
+  return parsed;
+}
+
+int main() {
+  // Example 1: Collect a batch, the values are moved out of the temporary
+  auto values = fst::collect(parse_batch({"1", "2", "3"}));
+
+  if (values) {
+    std::cout << "Collected:";
+    for (int value : *values) std::cout << ' ' << value;
+    std::cout << '\n';
+  }
+
+  // Example 2: Stop at the first error and report which element failed
+  std::vector<std::string> fields{"4", "five", "6"};
+  auto indexed = fst::collect_indexed(parse_batch(fields));
+
+  if (auto error = indexed.error()) {
+    std::cout << "Failed at " << *error << '\n';
+
+    // Retry the failing element only
+    fields[error->index] = "5";
+    indexed = fst::collect_indexed(parse_batch(fields));
+  }
+
+  std::cout << "Retried batch size: " << indexed.value().size() << '\n';
+
+  // Example 3: Append to a caller-provided container
+  std::vector<int> all{0};
+  auto status = fst::collect_into(parse_batch({"7", "8"}), all);
+
+  std::cout << "Collected into: " << (status ? "ok" : "error") << ", "
+            << all.size() << " values\n";
+
+  return 0;
+}
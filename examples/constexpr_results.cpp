@@ -0,0 +1,138 @@
+// Compile-time use of result, built as C++20: every check below is a
+// static_assert, so a broken combinator fails the build.
+
+#include <array>
+#include <iostream>
+#include <string_view>
+#include <utility>
+
+#include "fst/result.hpp"
+
+// Error with user-provided special members, which makes the results holding
+// it use the non-trivial copy, move and destroy paths.
+struct config_error {
+  std::string_view message;
+
+  constexpr explicit config_error(std::string_view text) : message(text) {}
+  constexpr config_error(const config_error& other) : message(other.message) {}
+  constexpr config_error& operator=(const config_error& other) {
+    message = other.message;
+    return *this;
+  }
+  constexpr ~config_error() {}
+};
+
+using port_result = fst::result<int, config_error>;
+
+constexpr port_result parse_port(std::string_view text) {
+  if (text.empty()) return config_error("empty port");
+  int port = 0;
+  for (char c : text) {
+    if (c < '0' || c > '9') return config_error("not a number");
+    port = port * 10 + (c - '0');
+    if (port > 65535) return config_error("out of range");
+  }
+  return port;
+}
+
+// Example 1: A configuration table validated while compiling
+constexpr std::array<port_result, 4> ports = {
+    parse_port("80"), parse_port("8080"), parse_port("http"),
+    parse_port("70000")};
+
+static_assert(ports[0].has_value() && *ports[0] == 80);
+static_assert(ports[1].value() == 8080);
+static_assert(ports[2].error()->message == "not a number");
+static_assert(ports[3].error()->message == "out of range");
+
+// Example 2: Every combinator in constant evaluation
+constexpr port_result half(int x) {
+  if (x % 2 != 0) return config_error("odd");
+  return x / 2;
+}
+
+static_assert(*parse_port("80").and_then(half) == 40);
+static_assert(parse_port("81").and_then(half).error()->message == "odd");
+static_assert(*parse_port("80").map([](int x) { return x + 1; }) == 81);
+static_assert(parse_port("")
+                  .map_error([](const config_error&) {
+                    return config_error("mapped");
+                  })
+                  .error()
+                  ->message == "mapped");
+static_assert(*parse_port("").or_else([](const config_error&) {
+  return port_result(443);
+}) == 443);
+static_assert(*parse_port("80").transform([](const port_result& r) {
+  return port_result(r.value_or(0) * 2);
+}) == 160);
+static_assert(parse_port("x").value_or(1) == 1);
+static_assert(*parse_port("80").inspect([](const port_result&) {}) == 80);
+static_assert(*parse_port("80").success() == 80);
+static_assert(parse_port("80").expect("valid port") == 80);
+static_assert(static_cast<bool>(parse_port("80")));
+static_assert(port_result().is_empty());
+
+// Example 3: Copies, moves, assignment and emplacement, which destroy and
+// construct payloads in place
+constexpr port_result reassigned() {
+  port_result r = parse_port("1");
+  port_result copy = r;
+  r = parse_port("x");
+  r = copy;
+  port_result moved = std::move(r);
+  moved.emplace_error("replaced");
+  moved.emplace_value(7);
+  copy = std::move(moved);
+  return copy;
+}
+
+static_assert(*reassigned() == 7);
+
+// Example 4: void and reference results
+constexpr fst::result<void, config_error> check_port(int port) {
+  if (port < 1024) return config_error("privileged port");
+  return fst::result<void, config_error>(fst::success_t);
+}
+
+static_assert(check_port(8080).has_value());
+static_assert(check_port(80).error()->message == "privileged port");
+static_assert(*check_port(8080).and_then([] { return port_result(1); }) == 1);
+
+constexpr int default_port = 8080;
+constexpr fst::result<const int&, config_error> default_ref(default_port);
+static_assert(*default_ref == 8080);
+static_assert(&default_ref.value() == &default_port);
+
+// Example 5: A result packed into the spare bits of an enum, one byte in
+// total. Packed results whose success type is a bool or a pointer are not
+// usable at compile time.
+enum class protocol : unsigned char { tcp, udp };
+enum class protocol_error : unsigned char { unknown, unsupported };
+
+template <>
+struct fst::niche_traits<protocol>
+    : fst::enum_niche_traits<protocol, protocol::udp> {};
+template <>
+struct fst::niche_traits<protocol_error>
+    : fst::enum_niche_traits<protocol_error, protocol_error::unsupported> {};
+
+using protocol_result = fst::result<protocol, protocol_error>;
+
+constexpr protocol_result parse_protocol(std::string_view text) {
+  if (text == "tcp") return protocol_result(fst::success_t, protocol::tcp);
+  if (text == "udp") return protocol_result(fst::success_t, protocol::udp);
+  return protocol_result(fst::error_t, protocol_error::unknown);
+}
+
+static_assert(sizeof(protocol_result) == 1);
+static_assert(*parse_protocol("udp") == protocol::udp);
+static_assert(*parse_protocol("sctp").error() == protocol_error::unknown);
+static_assert(parse_protocol("sctp").value_or(protocol::tcp) ==
+              protocol::tcp);
+
+int main() {
+  std::cout << "Validated " << ports.size() << " ports at compile time, first: "
+            << *ports[0] << '\n';
+  return 0;
+}
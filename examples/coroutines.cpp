@@ -0,0 +1,35 @@
+#include <iostream>
+#include <string>
+
+#include "fst/result.hpp"
+#include "fst/result_coroutine.hpp"
+
+// Parses a non-negative number
+fst::result<int, std::string> parse(const std::string& text) {
+  if (text.empty() || text.find_first_not_of("0123456789") != std::string::npos)
+    return std::string("Not a number: '" + text + "'");
+  return std::stoi(text);
+}
+
+// Fails for zero, without a success value
+fst::result<void, std::string> check_non_zero(int value) {
+  if (value == 0) co_await fst::result<void, std::string>(std::string("Zero"));
+  co_return;
+}
+
+// Each co_await returns early with the error of a failed result
+fst::result<int, std::string> ratio(const std::string& a,
+                                    const std::string& b) {
+  int numerator = co_await parse(a);
+  int denominator = co_await parse(b);
+  co_await check_non_zero(denominator);
+  co_return numerator / denominator;
+}
+
+int main() {
+  std::cout << "ratio(84, 2): " << ratio("84", "2") << '\n';
+  std::cout << "ratio(84, x): " << ratio("84", "x") << '\n';
+  std::cout << "ratio(84, 0): " << ratio("84", "0") << '\n';
+
+  return 0;
+}
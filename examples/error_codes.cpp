@@ -0,0 +1,45 @@
+#include <cstdint>
+#include <iostream>
+
+#include "fst/error_code.hpp"
+#include "fst/error_io.hpp"
+#include "fst/result.hpp"
+
+// Static category table, looked up only when a code is logged
+constexpr fst::error_code_entry rpc_entries[] = {
+    {0, "ok"}, {1, "timeout"}, {2, "connection refused"}, {3, "bad request"}};
+
+constexpr fst::error_category rpc_category("rpc", rpc_entries);
+
+// Registered once during static initialisation
+const fst::error_category_id rpc_errors =
+    fst::register_error_category(rpc_category);
+
+static_assert(sizeof(fst::result<std::int32_t, fst::error_code>) == 8,
+              "result<int32_t, error_code> must fit in 8 bytes");
+static_assert(std::is_trivially_copyable_v<
+                  fst::result<std::int32_t, fst::error_code>>,
+              "result<int32_t, error_code> must be trivially copyable");
+
+// Simulated RPC call, only the code travels through the hot path
+fst::result<std::int32_t, fst::error_code> call(std::int32_t request) {
+  if (request < 0) return fst::error_code(rpc_errors, 3);
+  if (request > 100) return fst::error_code(rpc_errors, 1);
+  return request * 2;
+}
+
+int main() {
+  for (std::int32_t request : {21, -1, 1000}) {
+    auto response = call(request);
+
+    if (response.has_error() && response.error()->value() == 1)
+      std::cout << "Retrying request " << request << '\n';
+
+    std::cout << "Request " << request << ": " << response << '\n';
+  }
+
+  // Codes of unregistered categories or values still stream safely
+  std::cout << "Unknown: " << fst::error_code(200, 7) << '\n';
+
+  return 0;
+}
@@ -1,14 +1,32 @@
 #include <iostream>
-#include <string>
 
+#include "fst/error_io.hpp"
+#include "fst/error_string.hpp"
 #include "fst/result.hpp"
 
-// Function that may fail and return a Result
-fst::result<double, std::string> div(double a, double b) {
-  if (b == 0.0)
-    return std::string(
-        "Division by zero error");  // Implicitly converts to std::string
-  return a / b;                     // Implicitly converts to double
+// Function that may fail and return a Result. The literal fits inline in
+// fst::error_string, so the error path does not allocate.
+fst::result<double, fst::error_string> div(double a, double b) {
+  if (b == 0.0) return "Division by zero error";
+  return a / b;  // Implicitly converts to double
+}
+
+// Validation with short dynamic messages, which are stored inline
+fst::result<int, fst::error_string> parse_digit(char c) {
+  if (c < '0' || c > '9') {
+    char message[] = "Not a digit: ' '";
+    message[14] = c;
+    return fst::error_string(message);
+  }
+  return c - '0';
+}
+
+// Long static messages are referenced with the _es literal instead of being
+// copied to the heap
+fst::result<int, fst::error_string> open_port(int port) {
+  using namespace fst::literals;
+  if (port < 1024) return "Ports below 1024 require elevated privileges"_es;
+  return port;
 }
 
 int main() {
@@ -18,5 +36,13 @@ int main() {
   // Example 2: Errored Result
   std::cout << "Result 2 error: " << div(5.0, 0.0) << '\n';
 
+  // Example 3: Errored Result with a dynamic message
+  std::cout << "Result 3 error: " << parse_digit('x') << '\n';
+
+  // Example 4: Errored Result referencing a static message
+  const auto port = open_port(80);
+  std::cout << "Result 4 error: " << port << " (static: " << std::boolalpha
+            << port.error()->is_static() << ")\n";
+
   return 0;
-}
\ No newline at end of file
+}
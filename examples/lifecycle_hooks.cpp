@@ -0,0 +1,84 @@
+#include <array>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "fst/result.hpp"
+
+// Per-thread ring buffer of lifecycle events. Each thread only touches its own
+// buffer, so recording an event needs neither a lock nor an atomic.
+struct event_record {
+  fst::lifecycle_event event;
+  const void* object;
+  fst::result_state state;
+};
+
+struct thread_event_sink {
+  static constexpr std::size_t capacity = 256;
+
+  std::array<event_record, capacity> events{};
+  std::size_t count = 0;
+
+  void record(const event_record& record) noexcept {
+    events[count++ % capacity] = record;
+  }
+};
+
+thread_local thread_event_sink sink;
+
+// Enables the lifecycle hooks for every result in this program.
+template <>
+struct fst::result_lifecycle<> {
+  static constexpr bool enabled = true;
+
+  static void on_event(fst::lifecycle_event event, const void* object,
+                       fst::result_state state) noexcept {
+    sink.record({event, object, state});
+  }
+};
+
+const char* to_string(fst::lifecycle_event event) {
+  switch (event) {
+    case fst::lifecycle_event::construct:
+      return "construct";
+    case fst::lifecycle_event::copy:
+      return "copy";
+    case fst::lifecycle_event::move:
+      return "move";
+    case fst::lifecycle_event::destroy:
+      return "destroy";
+    case fst::lifecycle_event::state_change:
+      return "state_change";
+    default:
+      return "unknown";
+  }
+}
+
+fst::result<int, std::string> parse(const std::string& text) {
+  if (text.empty()) return std::string("Empty input");
+  return static_cast<int>(text.size());
+}
+
+int main() {
+  std::thread worker([] {
+    auto res = parse("worker").map([](int n) { return n * 2; });
+    std::cout << "Worker recorded " << sink.count << " events\n";
+  });
+  worker.join();
+
+  {
+    auto res = parse("");
+    auto copy = res;
+    copy = parse("main");
+  }
+
+  std::cout << "Main recorded " << sink.count << " events:\n";
+  for (std::size_t i = 0; i < sink.count; ++i) {
+    const auto& record = sink.events[i];
+    std::cout << "  " << to_string(record.event) << " @ STATE: "
+              << record.state << '\n';
+  }
+
+  return 0;
+}
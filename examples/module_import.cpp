@@ -0,0 +1,22 @@
+#include <iostream>
+#include <string>
+
+import fst.result;
+
+fst::result<int, std::string> half(int x) {
+  if (x % 2 != 0) return std::to_string(x) + " is odd";
+  return x / 2;
+}
+
+int main() {
+  // The panic handler is only called when exceptions are disabled
+  const fst::panic_handler handler = fst::get_panic_handler();
+  fst::set_panic_handler(handler);
+
+  for (int x : {8, 3}) {
+    const auto r = half(x).and_then(half);
+    std::cout << x << ": " << r << " (" << fst::to_string(r.state())
+              << ")\n";
+  }
+  return 0;
+}
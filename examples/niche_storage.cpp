@@ -0,0 +1,72 @@
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#include "fst/result.hpp"
+
+enum class lookup_error : unsigned char { not_found, expired, forbidden };
+
+// Declares that only the two lowest bits of lookup_error are ever used, so
+// result can keep its state in the remaining ones.
+template <>
+struct fst::niche_traits<lookup_error>
+    : fst::enum_niche_traits<lookup_error, lookup_error::forbidden> {};
+
+enum class parse_error : std::int32_t { empty, invalid };
+
+struct record {
+  std::int64_t id;
+  std::string name;
+};
+
+// The state is packed into the alignment bits of the pointers.
+static_assert(sizeof(fst::result<record*, std::string*>) == sizeof(void*));
+
+// The state is packed into the spare bits of bool and lookup_error.
+static_assert(sizeof(fst::result<bool, lookup_error>) == 1);
+
+// No spare bits, but the state byte still fits in one 64-bit register.
+static_assert(sizeof(fst::result<std::int32_t, parse_error>) == 8);
+
+fst::result<bool, lookup_error> is_admin(const std::string& user) {
+  if (user.empty())
+    return fst::result<bool, lookup_error>(lookup_error::not_found);
+  return fst::result<bool, lookup_error>(user == "root");
+}
+
+const char* to_string(lookup_error error) {
+  switch (error) {
+    case lookup_error::not_found:
+      return "not found";
+    case lookup_error::expired:
+      return "expired";
+    case lookup_error::forbidden:
+      return "forbidden";
+    default:
+      return "unknown";
+  }
+}
+
+int main() {
+  record root{0, "root"};
+  std::string missing = "no such record";
+
+  fst::result<record*, std::string*> found(&root);
+  fst::result<record*, std::string*> not_found(&missing);
+
+  std::cout << "Found: " << found.value()->name << '\n';
+  std::cout << "Not found: " << **not_found.error() << '\n';
+
+  for (const std::string user : {"root", "guest", ""}) {
+    auto admin = is_admin(user);
+    if (admin) {
+      std::cout << '"' << user << "\" is admin: " << std::boolalpha
+                << admin.value() << '\n';
+    } else {
+      std::cout << '"' << user << "\" lookup failed: "
+                << to_string(*admin.error()) << '\n';
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,40 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "fst/result.hpp"
+
+// Built with -fno-exceptions (or FST_NO_EXCEPTIONS defined), an invalid
+// access calls the panic handler instead of throwing bad_result_access.
+
+fst::result<int, std::string> lookup(int id) {
+  if (id == 42) return 7;
+  return std::string("No record with id ") + std::to_string(id);
+}
+
+// Logs the failed access and ends the process, a panic handler must not
+// return
+[[noreturn]] void log_and_exit(const fst::bad_result_access& error) noexcept {
+  std::cout << "Panic: " << error.what() << '\n';
+  std::exit(EXIT_SUCCESS);
+}
+
+int main() {
+  fst::set_panic_handler(log_and_exit);
+
+  std::cout << "Record 42: " << lookup(42).value() << '\n';
+
+#if defined(FST_NO_EXCEPTIONS)
+  const int record = lookup(7).expect("record 7 is required");
+  std::cout << "Record 7: " << record << '\n';
+#else
+  try {
+    const int record = lookup(7).expect("record 7 is required");
+    std::cout << "Record 7: " << record << '\n';
+  } catch (const fst::bad_result_access& error) {
+    std::cout << "Exception: " << error.what() << '\n';
+  }
+#endif
+
+  return 0;
+}
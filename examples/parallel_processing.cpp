@@ -0,0 +1,48 @@
+#include <cmath>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "fst/parallel.hpp"
+#include "fst/result.hpp"
+
+// Work item that fails for negative inputs
+fst::result<double, std::string> checked_sqrt(int x) {
+  if (x < 0) return std::string("Negative input: " + std::to_string(x));
+  return std::sqrt(static_cast<double>(x));
+}
+
+int main() {
+  std::vector<int> inputs(1000000);
+  std::iota(inputs.begin(), inputs.end(), 0);
+
+  // A local pool, the algorithms use all hardware threads by default
+  fst::thread_pool pool(4);
+
+  // Example 1: Transform in parallel, values are collected in input order
+  auto roots =
+      fst::parallel_transform(pool, inputs.begin(), inputs.end(), checked_sqrt);
+  std::cout << "Roots computed: " << roots.value().size()
+            << ", last: " << roots.value().back() << '\n';
+
+  // Example 2: Reduce in parallel
+  auto sum = fst::parallel_reduce(
+      pool, inputs.begin(), inputs.end(), 0.0, checked_sqrt,
+      [](double a, double b) { return a + b; });
+  std::cout << "Sum of roots: " << sum << '\n';
+
+  // Example 3: The first failing element cancels the remaining work, with
+  // lowest_index the reported error is the same on every run
+  inputs[1234] = -1;
+  inputs[567890] = -2;
+
+  fst::parallel_options options;
+  options.order = fst::error_order::lowest_index;
+
+  auto failed = fst::parallel_transform(pool, inputs.begin(), inputs.end(),
+                                        checked_sqrt, options);
+  std::cout << "Failed: " << *failed.error() << '\n';
+
+  return 0;
+}
@@ -0,0 +1,51 @@
+#include <charconv>
+#include <iostream>
+#include <string>
+#include <system_error>
+
+#include "fst/pipeline.hpp"
+#include "fst/result.hpp"
+
+fst::result<int, std::string> parse(const std::string& text) {
+  int value = 0;
+  const char* end = text.data() + text.size();
+  const auto parsed = std::from_chars(text.data(), end, value);
+  if (parsed.ec != std::errc() || parsed.ptr != end)
+    return std::string("Not a number: " + text);
+  return value;
+}
+
+fst::result<int, std::string> check_positive(int x) {
+  if (x <= 0) return std::string("Not positive: " + std::to_string(x));
+  return x;
+}
+
+int main() {
+  // Example 1: Compose the stages once, the pipeline checks the state of the
+  // input once and only the results of fallible stages again
+  const auto normalise =
+      fst::pipe | fst::and_then(check_positive)
+      | fst::map([](int x) { return x * 0.5; })
+      | fst::map_error([](const std::string& e) { return e.size(); });
+
+  auto half = normalise(parse("42"));
+  std::cout << "Half: " << half << '\n';
+
+  // Example 2: Apply a pipeline with |, map_error changed the error type
+  auto failed = parse("-3") | normalise;
+  std::cout << "Error length: " << *failed.error() << '\n';
+
+  // Example 3: or_else recovers, later stages run on the recovered value
+  const auto with_default =
+      fst::pipe | fst::and_then(check_positive)
+      | fst::or_else([](const std::string& e) {
+          std::cout << "Using default after: " << e << '\n';
+          return fst::result<int, std::string>(1);
+        })
+      | fst::map([](int x) { return x + 1; });
+
+  auto recovered = with_default(parse("abc"));
+  std::cout << "Recovered: " << recovered << '\n';
+
+  return 0;
+}
@@ -0,0 +1,65 @@
+#include <charconv>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <system_error>
+
+#include "fst/error_code.hpp"
+#include "fst/error_io.hpp"
+#include "fst/result.hpp"
+
+// Built against result-cpp-precompiled: the members of the four result
+// types below are not instantiated here but taken from the library.
+
+constexpr fst::error_code_entry net_entries[] = {{0, "ok"},
+                                                 {1, "unreachable"}};
+
+constexpr fst::error_category net_category("net", net_entries);
+
+const fst::error_category_id net_errors =
+    fst::register_error_category(net_category);
+
+fst::result<std::string, std::string> read_setting(const std::string& key) {
+  if (key == "port") return {fst::success_t, std::string("8080")};
+  if (key == "ratio") return {fst::success_t, std::string("0.75")};
+  return {fst::error_t, "unknown setting: " + key};
+}
+
+fst::result<int, std::string> parse_port(const std::string& text) {
+  int port = 0;
+  const char* end = text.data() + text.size();
+  const auto parsed = std::from_chars(text.data(), end, port);
+  if (parsed.ec != std::errc() || parsed.ptr != end)
+    return std::string("invalid port: ") + text;
+  return port;
+}
+
+fst::result<double, std::string> parse_ratio(const std::string& text) {
+  char* end = nullptr;
+  const double ratio = std::strtod(text.c_str(), &end);
+  if (text.empty() || *end != '\0')
+    return std::string("invalid ratio: ") + text;
+  return ratio;
+}
+
+fst::result<void, fst::error_code> connect(int port) {
+  if (port != 8080) return fst::error_code(net_errors, 1);
+  return fst::success_t;
+}
+
+int main() {
+  const auto port = read_setting("port").and_then(parse_port);
+  const auto ratio = read_setting("ratio").and_then(parse_ratio);
+  const auto missing = read_setting("timeout").and_then(parse_port);
+
+  std::cout << "Port: " << port << '\n';
+  std::cout << "Ratio: " << ratio << '\n';
+  std::cout << "Timeout: " << missing << '\n';
+
+  const auto connection = connect(port.value_or(0));
+  std::cout << "Connected: " << std::boolalpha << connection.has_value()
+            << '\n';
+  std::cout << "Unreachable: " << connect(9090) << '\n';
+
+  return 0;
+}
@@ -0,0 +1,42 @@
+#include <cstddef>
+#include <iostream>
+#include <string>
+
+#include "fst/result.hpp"
+#include "fst/result_vector.hpp"
+
+// Simulated measurement, fails for every thousandth sample
+fst::result<int, std::string> sample(int i) {
+  if (i % 1000 == 999) return std::string("sensor timeout");
+  return i % 100;
+}
+
+int main() {
+  constexpr std::size_t count = 1000000;
+
+  fst::result_vector<int, std::string> samples;
+  samples.reserve(count);
+  for (std::size_t i = 0; i < count; ++i)
+    samples.push_back(sample(static_cast<int>(i)));
+
+  // Counting and locating use the state bitmap and the error side-table
+  std::cout << "Successes: " << samples.count_values() << '\n';
+  std::cout << "Errors: " << samples.count_errors() << '\n';
+  std::cout << "First error at: " << samples.find_first_error() << " ("
+            << samples[samples.find_first_error()] << ")\n";
+
+  // Iterate only the successful values
+  long long sum = 0;
+  samples.for_each_value([&sum](std::size_t, int value) { sum += value; });
+  std::cout << "Sum of values: " << sum << '\n';
+
+  // Elements are proxies exposing the result API
+  samples[999] = fst::result<int, std::string>(fst::success_t, 42);
+  std::cout << "Repaired element: " << samples[999].value_or(0) << '\n';
+
+  std::cout << "Bytes per element, std::vector<result<int, std::string>>: "
+            << sizeof(fst::result<int, std::string>)
+            << ", result_vector: about " << sizeof(int) << " + 2 bits\n";
+
+  return 0;
+}
@@ -0,0 +1,44 @@
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "fst/result.hpp"
+
+// A result of trivial payloads is itself trivially copyable, so it can be
+// passed in registers and copied with memcpy by containers.
+static_assert(std::is_trivially_copyable_v<fst::result<int, int>>);
+static_assert(std::is_trivially_copyable_v<fst::result<double, int>>);
+static_assert(std::is_trivially_copyable_v<fst::result<std::int64_t, char>>);
+static_assert(std::is_trivially_destructible_v<fst::result<int, int>>);
+
+static_assert(sizeof(fst::result<char, char>) == 2);
+static_assert(sizeof(fst::result<int, int>) == 8);
+static_assert(sizeof(fst::result<int, char>) == 8);
+static_assert(sizeof(fst::result<double, int>) == 16);
+
+// Non-trivial payloads keep non-trivial special members, but moves stay
+// noexcept so std::vector moves instead of copying on reallocation.
+static_assert(!std::is_trivially_copyable_v<fst::result<std::string, int>>);
+static_assert(
+    std::is_nothrow_move_constructible_v<fst::result<std::string, int>>);
+static_assert(
+    std::is_nothrow_move_assignable_v<fst::result<std::string, std::string>>);
+
+fst::result<int, int> parse_digit(char c) {
+  if (c < '0' || c > '9')
+    return fst::result<int, int>(fst::error_t, static_cast<int>(c));
+  return fst::result<int, int>(fst::success_t, c - '0');
+}
+
+int main() {
+  std::vector<fst::result<int, int>> digits;
+  for (char c : std::string("4a2")) digits.push_back(parse_digit(c));
+
+  for (const auto& digit : digits) {
+    std::cout << digit.state() << ": " << digit << '\n';
+  }
+
+  return 0;
+}
@@ -0,0 +1,49 @@
+#include <iostream>
+#include <string>
+#include <tuple>
+
+#include "fst/algorithm.hpp"
+#include "fst/error_io.hpp"
+#include "fst/error_string.hpp"
+#include "fst/result.hpp"
+
+struct record {
+  std::string name;
+  int age;
+  std::string email;
+};
+
+fst::result<std::string, fst::error_string> check_name(const record& r) {
+  if (r.name.empty()) return fst::error_string("name is empty");
+  return r.name;
+}
+
+fst::result<int, fst::error_string> check_age(const record& r) {
+  if (r.age < 0 || r.age > 150) return fst::error_string("age out of range");
+  return r.age;
+}
+
+fst::result<std::string, fst::error_string> check_email(const record& r) {
+  if (r.email.find('@') == std::string::npos)
+    return fst::error_string("email has no '@'");
+  return r.email;
+}
+
+int main() {
+  const record records[] = {{"Ada", 36, "ada@example.com"}, {"", 200, "nope"}};
+
+  for (const auto& r : records) {
+    // Every check runs, all failures are reported in one pass
+    auto validated = fst::validate(check_name(r), check_age(r), check_email(r));
+
+    if (validated) {
+      const auto& [name, age, email] = *validated;
+      std::cout << "Valid: " << name << ", " << age << ", " << email << '\n';
+    } else {
+      std::cout << "Invalid (" << validated.error()->size()
+                << " errors): " << *validated.error() << '\n';
+    }
+  }
+
+  return 0;
+}
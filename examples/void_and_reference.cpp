@@ -0,0 +1,36 @@
+#include <iostream>
+#include <map>
+#include <string>
+
+#include "fst/result.hpp"
+
+std::map<std::string, int> inventory = {{"apple", 3}, {"pear", 0}};
+
+// Returns a reference to the stored count instead of a copy
+fst::result<int&, std::string> find_item(const std::string& name) {
+  auto it = inventory.find(name);
+  if (it == inventory.end()) return std::string("No such item: " + name);
+  return it->second;
+}
+
+// Succeeds without producing a value
+fst::result<void, std::string> take_item(int& count) {
+  if (count == 0) return std::string("Out of stock");
+  --count;
+  return fst::success_t;
+}
+
+int main() {
+  for (const char* name : {"apple", "pear", "plum"}) {
+    auto taken = find_item(name).and_then(take_item);
+
+    if (taken) {
+      std::cout << "Took one " << name << ", " << find_item(name).value()
+                << " left\n";
+    } else {
+      std::cout << "Could not take " << name << ": " << taken << '\n';
+    }
+  }
+
+  return 0;
+}
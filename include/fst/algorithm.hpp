@@ -0,0 +1,471 @@
+// algorithm.hpp
+#ifndef FST_ALGORITHM_HPP
+#define FST_ALGORITHM_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "fst/result_core.hpp"
+
+namespace fst {
+
+/**
+ * @brief Error of a range operation together with the index of the element
+ * that produced it.
+ *
+ * @tparam E The type of the error value.
+ */
+template <typename E>
+struct indexed_error {
+  std::size_t index;
+  E error;
+};
+
+/**
+ * @brief List of errors with inline storage for the first few elements.
+ *
+ * The first `N` errors are stored inside the object, only further errors are
+ * moved to a heap-allocated overflow vector. Returned by validate(), so the
+ * success case and the few-errors case never allocate.
+ *
+ * @tparam E The type of the error values.
+ * @tparam N The number of errors stored inline.
+ */
+template <typename E, std::size_t N = 4>
+class error_list {
+  static_assert(N > 0, "error_list needs room for at least one inline error");
+
+  template <bool Const>
+  class basic_iterator {
+    using owner_type = std::conditional_t<Const, const error_list, error_list>;
+
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = E;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const E*, E*>;
+    using reference = std::conditional_t<Const, const E&, E&>;
+
+    basic_iterator() noexcept = default;
+    basic_iterator(owner_type* owner, std::size_t index) noexcept
+        : m_owner(owner), m_index(index) {}
+
+    reference operator*() const noexcept { return (*m_owner)[m_index]; }
+    pointer operator->() const noexcept { return &(*m_owner)[m_index]; }
+
+    basic_iterator& operator++() noexcept {
+      ++m_index;
+      return *this;
+    }
+
+    basic_iterator operator++(int) noexcept {
+      basic_iterator copy = *this;
+      ++m_index;
+      return copy;
+    }
+
+    friend bool operator==(const basic_iterator& lhs,
+                           const basic_iterator& rhs) noexcept {
+      return lhs.m_index == rhs.m_index;
+    }
+
+    friend bool operator!=(const basic_iterator& lhs,
+                           const basic_iterator& rhs) noexcept {
+      return !(lhs == rhs);
+    }
+
+   private:
+    owner_type* m_owner = nullptr;
+    std::size_t m_index = 0;
+  };
+
+ public:
+  using value_type = E;
+  using size_type = std::size_t;
+  using iterator = basic_iterator<false>;
+  using const_iterator = basic_iterator<true>;
+
+  /// Number of errors stored without allocating.
+  static constexpr size_type inline_capacity = N;
+
+  error_list() noexcept = default;
+
+  // The copy and move constructors delegate to the default constructor, so
+  // the destructor releases the errors constructed so far if one throws.
+  error_list(const error_list& other) : error_list() {
+    for (; m_size < other.m_size && m_size < N; ++m_size)
+      ::new (inline_slot(m_size)) E(other[m_size]);
+    m_overflow = other.m_overflow;
+    m_size = other.m_size;
+  }
+
+  error_list(error_list&& other) noexcept(
+      std::is_nothrow_move_constructible_v<E>)
+      : error_list() {
+    m_overflow = std::move(other.m_overflow);
+    for (; m_size < other.m_size && m_size < N; ++m_size)
+      ::new (inline_slot(m_size)) E(std::move(other[m_size]));
+    m_size = other.m_size;
+    other.clear();
+  }
+
+  error_list& operator=(const error_list& other) {
+    if (this != &other) {
+      error_list copy(other);
+      *this = std::move(copy);
+    }
+    return *this;
+  }
+
+  error_list& operator=(error_list&& other) noexcept(
+      std::is_nothrow_move_constructible_v<E>) {
+    if (this != &other) {
+      clear();
+      m_overflow = std::move(other.m_overflow);
+      for (; m_size < other.m_size && m_size < N; ++m_size)
+        ::new (inline_slot(m_size)) E(std::move(other[m_size]));
+      m_size = other.m_size;
+      other.clear();
+    }
+    return *this;
+  }
+
+  ~error_list() { clear(); }
+
+  /**
+   * @brief Appends an error constructed in place.
+   *
+   * @return Reference to the new error.
+   */
+  template <typename... Args>
+  E& emplace_back(Args&&... args) {
+    if (m_size < N) {
+      E* error = ::new (inline_slot(m_size)) E(std::forward<Args>(args)...);
+      ++m_size;
+      return *error;
+    }
+    E& error = m_overflow.emplace_back(std::forward<Args>(args)...);
+    ++m_size;
+    return error;
+  }
+
+  void push_back(const E& error) { emplace_back(error); }
+
+  void push_back(E&& error) { emplace_back(std::move(error)); }
+
+  /**
+   * @brief Removes all errors.
+   */
+  void clear() noexcept {
+    for (size_type i = 0; i < m_size && i < N; ++i) inline_slot(i)->~E();
+    m_overflow.clear();
+    m_size = 0;
+  }
+
+  size_type size() const noexcept { return m_size; }
+
+  bool empty() const noexcept { return m_size == 0; }
+
+  E& operator[](size_type index) noexcept {
+    return index < N ? *inline_slot(index) : m_overflow[index - N];
+  }
+
+  const E& operator[](size_type index) const noexcept {
+    return index < N ? *inline_slot(index) : m_overflow[index - N];
+  }
+
+  E& front() noexcept { return (*this)[0]; }
+
+  const E& front() const noexcept { return (*this)[0]; }
+
+  iterator begin() noexcept { return {this, 0}; }
+  iterator end() noexcept { return {this, m_size}; }
+  const_iterator begin() const noexcept { return {this, 0}; }
+  const_iterator end() const noexcept { return {this, m_size}; }
+
+ private:
+  E* inline_slot(size_type index) noexcept {
+    return std::launder(reinterpret_cast<E*>(m_inline) + index);
+  }
+
+  const E* inline_slot(size_type index) const noexcept {
+    return std::launder(reinterpret_cast<const E*>(m_inline) + index);
+  }
+
+  alignas(E) unsigned char m_inline[N * sizeof(E)];
+  size_type m_size = 0;
+  std::vector<E> m_overflow;
+};
+
+namespace detail {
+
+template <typename R>
+struct result_element;
+
+template <typename T, typename E>
+struct result_element<result<T, E>> {
+  static_assert(std::is_object_v<T>,
+                "range algorithms require results with an object value type");
+  using value_type = T;
+  using error_type = E;
+};
+
+template <typename It>
+using result_element_t = result_element<
+    std::remove_cv_t<typename std::iterator_traits<It>::value_type>>;
+
+template <typename C, typename = void>
+struct has_reserve : std::false_type {};
+
+template <typename C>
+struct has_reserve<C, std::void_t<decltype(std::declval<C&>().reserve(
+                          std::declval<typename C::size_type>()))>>
+    : std::true_type {};
+
+template <typename C, typename V, typename = void>
+struct has_emplace_back : std::false_type {};
+
+template <typename C, typename V>
+struct has_emplace_back<C, V,
+                        std::void_t<decltype(std::declval<C&>().emplace_back(
+                            std::declval<V>()))>> : std::true_type {};
+
+// Reserves room for the remaining elements when their number is known
+// without consuming the range.
+template <typename Container, typename It>
+void reserve_for(Container& out, It first, It last) {
+  if constexpr (has_reserve<Container>::value &&
+                std::is_base_of_v<
+                    std::forward_iterator_tag,
+                    typename std::iterator_traits<It>::iterator_category>) {
+    out.reserve(out.size() +
+                static_cast<typename Container::size_type>(
+                    std::distance(first, last)));
+  }
+}
+
+template <typename Container, typename V>
+void append_to(Container& out, V&& value) {
+  if constexpr (has_emplace_back<Container, V&&>::value)
+    out.emplace_back(std::forward<V>(value));
+  else
+    out.insert(out.end(), std::forward<V>(value));
+}
+
+// Appends the values of [first, last) to `out` and stops at the first element
+// that does not hold a value. Elements are moved from when the iterator yields
+// rvalues. `make_error` builds the reported error from the index and the
+// error value of the failing element.
+template <typename Error, typename It, typename Container, typename MakeError>
+result<void, Error> collect_values(It first, It last, Container& out,
+                                   MakeError&& make_error) {
+  reserve_for(out, first, last);
+
+  for (std::size_t index = 0; first != last; ++first, ++index) {
+    auto&& current = *first;
+    if (!current.has_value()) {
+      if (!current.has_error()) return result<void, Error>();
+      return result<void, Error>(
+          error_t,
+          make_error(index, *std::forward<decltype(current)>(current).error()));
+    }
+    append_to(out, std::forward<decltype(current)>(current).value());
+  }
+  return result<void, Error>(success_t);
+}
+
+// Passes the error value through unchanged.
+struct plain_error {
+  template <typename E>
+  E&& operator()(std::size_t, E&& error) const noexcept {
+    return std::forward<E>(error);
+  }
+};
+
+// Pairs the error value with the index of the failing element.
+struct with_index {
+  template <typename E>
+  indexed_error<std::decay_t<E>> operator()(std::size_t index,
+                                            E&& error) const {
+    return {index, std::forward<E>(error)};
+  }
+};
+
+// Collects [first, last) into a vector, reporting errors built by MakeError.
+template <typename It, typename MakeError>
+auto collect_vector(It first, It last, MakeError make_error) {
+  using element = result_element_t<It>;
+  using vector_type = std::vector<typename element::value_type>;
+  using error_type = std::decay_t<std::invoke_result_t<
+      MakeError, std::size_t, typename element::error_type&&>>;
+  using result_type = result<vector_type, error_type>;
+
+  vector_type values;
+  auto status = collect_values<error_type>(first, last, values, make_error);
+  return status.has_value()
+             ? result_type(success_t, std::move(values))
+         : status.has_error()
+             ? result_type(error_t, *std::move(status).error())
+             : result_type();
+}
+
+template <typename Range>
+auto range_begin(Range&& range) {
+  using std::begin;
+  if constexpr (std::is_lvalue_reference_v<Range>)
+    return begin(range);
+  else
+    return std::make_move_iterator(begin(range));
+}
+
+template <typename Range>
+auto range_end(Range&& range) {
+  using std::end;
+  if constexpr (std::is_lvalue_reference_v<Range>)
+    return end(range);
+  else
+    return std::make_move_iterator(end(range));
+}
+
+}  // namespace detail
+
+/**
+ * @brief Appends the values of a sequence of results to a container, stopping
+ * at the first element that is not successful.
+ *
+ * Works with input iterators. When the number of elements is known up front
+ * and the container has `reserve()`, room is reserved once. Pass move
+ * iterators to move the values out of the sequence.
+ *
+ * @param first The beginning of the sequence of results.
+ * @param last The end of the sequence of results.
+ * @param out The container receiving the values, on failure it keeps the
+ * values appended before the failing element.
+ * @return A successful result, the error of the first failing element, or an
+ * empty result if that element is empty.
+ */
+template <typename It, typename Container>
+auto collect_into(It first, It last, Container& out) {
+  return detail::collect_values<
+      typename detail::result_element_t<It>::error_type>(
+      first, last, out, detail::plain_error{});
+}
+
+/**
+ * @brief Range overload of collect_into(), moves values out of rvalue ranges.
+ */
+template <typename Range, typename Container>
+auto collect_into(Range&& range, Container& out) {
+  return collect_into(detail::range_begin(std::forward<Range>(range)),
+                      detail::range_end(std::forward<Range>(range)), out);
+}
+
+/**
+ * @brief Collects a sequence of results into a result holding a vector of
+ * their values, stopping at the first element that is not successful.
+ *
+ * @param first The beginning of the sequence of results.
+ * @param last The end of the sequence of results.
+ * @return The vector of values, the error of the first failing element, or an
+ * empty result if that element is empty.
+ */
+template <typename It>
+auto collect(It first, It last) {
+  return detail::collect_vector(first, last, detail::plain_error{});
+}
+
+/**
+ * @brief Range overload of collect(), moves values out of rvalue ranges.
+ */
+template <typename Range>
+auto collect(Range&& range) {
+  return collect(detail::range_begin(std::forward<Range>(range)),
+                 detail::range_end(std::forward<Range>(range)));
+}
+
+/**
+ * @brief Same as collect(), but the error also carries the index of the
+ * failing element so batch callers can retry from it.
+ *
+ * @param first The beginning of the sequence of results.
+ * @param last The end of the sequence of results.
+ * @return The vector of values, the index and error of the first failing
+ * element, or an empty result if that element is empty.
+ */
+template <typename It>
+auto collect_indexed(It first, It last) {
+  return detail::collect_vector(first, last, detail::with_index{});
+}
+
+/**
+ * @brief Range overload of collect_indexed(), moves values out of rvalue
+ * ranges.
+ */
+template <typename Range>
+auto collect_indexed(Range&& range) {
+  return collect_indexed(detail::range_begin(std::forward<Range>(range)),
+                         detail::range_end(std::forward<Range>(range)));
+}
+
+/**
+ * @brief Combines several results, reporting every error instead of stopping
+ * at the first one.
+ *
+ * All results must have the same error type. Values are moved out of rvalue
+ * results.
+ *
+ * @code
+ * auto record = fst::validate(parse_name(row), parse_age(row));
+ * // result<std::tuple<std::string, int>, fst::error_list<std::string>>
+ * @endcode
+ *
+ * @param results The results to combine.
+ * @return A tuple of all values if every result is successful, otherwise the
+ * errors of all failed results in argument order, or an empty result if no
+ * result failed but some are empty.
+ */
+template <typename... Rs>
+auto validate(Rs&&... results) {
+  static_assert(sizeof...(Rs) > 0, "validate needs at least one result");
+  using E = typename detail::result_element<
+      std::decay_t<std::tuple_element_t<0, std::tuple<Rs...>>>>::error_type;
+  static_assert((std::is_same_v<typename detail::result_element<
+                                    std::decay_t<Rs>>::error_type,
+                                E> &&
+                 ...),
+                "validate requires results with the same error type");
+
+  using tuple_type = std::tuple<
+      typename detail::result_element<std::decay_t<Rs>>::value_type...>;
+  using result_type = result<tuple_type, error_list<E>>;
+
+  if ((results.has_value() && ...))
+    return result_type(success_t,
+                       tuple_type(std::forward<Rs>(results).value()...));
+
+  error_list<E> errors;
+  ((results.has_error()
+        ? void(errors.push_back(*std::forward<Rs>(results).error()))
+        : void()),
+   ...);
+  return errors.empty() ? result_type()
+                        : result_type(error_t, std::move(errors));
+}
+
+/**
+ * @brief Alias of validate(), combines the values of several results into a
+ * tuple while accumulating all errors.
+ */
+template <typename... Rs>
+auto zip_all(Rs&&... results) {
+  return validate(std::forward<Rs>(results)...);
+}
+
+}  // namespace fst
+
+#endif  // FST_ALGORITHM_HPP
@@ -0,0 +1,582 @@
+// async_result.hpp
+#ifndef FST_ASYNC_RESULT_HPP
+#define FST_ASYNC_RESULT_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "fst/parallel.hpp"
+#include "fst/result_core.hpp"
+
+namespace fst {
+
+template <typename T, typename E>
+class async_result;
+
+template <typename T, typename E>
+class async_promise;
+
+namespace detail {
+
+template <typename T, typename E>
+class async_state;
+
+// Continuation attached to an async_state, run exactly once with the state
+// when its result is ready. Continuations must not throw.
+template <typename T, typename E>
+class async_continuation {
+ public:
+  virtual void run(async_state<T, E>& source) noexcept = 0;
+
+ protected:
+  ~async_continuation() = default;
+};
+
+// Intrusively reference counted base of the shared states.
+class async_ref_counted {
+ public:
+  void add_ref() noexcept { m_refs.fetch_add(1, std::memory_order_relaxed); }
+
+  void release() noexcept {
+    if (m_refs.fetch_sub(1, std::memory_order_acq_rel) == 1) delete this;
+  }
+
+ protected:
+  explicit async_ref_counted(std::size_t refs) noexcept : m_refs(refs) {}
+  virtual ~async_ref_counted() = default;
+
+ private:
+  std::atomic<std::size_t> m_refs;
+};
+
+// Shared state of an async_result. `m_status` is 0 while pending without
+// continuation, the address of the continuation once one is attached, and 1
+// once the result is ready; completing and attaching are each a single atomic
+// operation on it, whichever comes second runs the continuation.
+template <typename T, typename E>
+class async_state : public async_ref_counted {
+ public:
+  explicit async_state(std::size_t refs) noexcept : async_ref_counted(refs) {}
+
+  // Stores the result and runs the attached continuation, if any.
+  void set(result<T, E>&& outcome) noexcept {
+    m_result.emplace(std::move(outcome));
+    const std::uintptr_t previous =
+        m_status.exchange(ready, std::memory_order_acq_rel);
+    if (previous != pending)
+      reinterpret_cast<async_continuation<T, E>*>(previous)->run(*this);
+  }
+
+  // Attaches the continuation, runs it immediately if the result is ready.
+  void attach(async_continuation<T, E>& continuation) noexcept {
+    std::uintptr_t expected = pending;
+    if (!m_status.compare_exchange_strong(
+            expected, reinterpret_cast<std::uintptr_t>(&continuation),
+            std::memory_order_acq_rel, std::memory_order_acquire))
+      continuation.run(*this);
+  }
+
+  bool is_ready() const noexcept {
+    return m_status.load(std::memory_order_acquire) == ready;
+  }
+
+  // Moves the result out, only valid once and once ready.
+  result<T, E> take() noexcept(
+      std::is_nothrow_move_constructible_v<result<T, E>>) {
+    return std::move(*m_result);
+  }
+
+ private:
+  static constexpr std::uintptr_t pending = 0;
+  static constexpr std::uintptr_t ready = 1;
+
+  std::atomic<std::uintptr_t> m_status{pending};
+  std::optional<result<T, E>> m_result;
+};
+
+// Reports an operation on a handle or promise without a state, because it
+// was moved from or already consumed, as an invalid access.
+[[noreturn]] FST_COLD inline void throw_async_access(const char* reason) {
+  raise_bad_result_access(bad_result_access(reason));
+}
+
+template <typename R>
+struct async_of;
+
+template <typename T, typename E>
+struct async_of<result<T, E>> {
+  using state = async_state<T, E>;
+  using handle = async_result<T, E>;
+  using promise = async_promise<T, E>;
+};
+
+// Grants the combinators access to the state behind a handle.
+struct async_access {
+  template <typename T, typename E>
+  static async_state<T, E>& state(async_result<T, E>& handle) {
+    if (!handle.m_state) throw_async_access("async_result has no state");
+    return *handle.m_state;
+  }
+
+  template <typename T, typename E>
+  static async_result<T, E> adopt(async_state<T, E>* state) noexcept {
+    return async_result<T, E>(state);
+  }
+};
+
+// State of a continuation stage, it holds the operation applied to the
+// upstream result so attaching it allocates nothing beyond the stage itself.
+template <typename T, typename E, typename Op,
+          typename R = std::invoke_result_t<Op&, result<T, E>&&>>
+class then_state final : public async_of<R>::state,
+                         public async_continuation<T, E> {
+ public:
+  // One reference for the returned handle, one held by the upstream state
+  // until the continuation has run.
+  explicit then_state(Op op) : async_of<R>::state(2), m_op(std::move(op)) {}
+
+  void run(async_state<T, E>& source) noexcept override {
+    this->set(m_op(source.take()));
+    this->release();
+  }
+
+ private:
+  Op m_op;
+};
+
+// Continuation waking a blocked get(), lives on the waiting thread's stack.
+template <typename T, typename E>
+class async_waiter final : public async_continuation<T, E> {
+ public:
+  void run(async_state<T, E>&) noexcept override {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_done = true;
+    m_ready.notify_one();
+  }
+
+  void wait() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_ready.wait(lock, [this] { return m_done; });
+  }
+
+ private:
+  std::mutex m_mutex;
+  std::condition_variable m_ready;
+  bool m_done = false;
+};
+
+template <typename E, typename Indices, typename... Ts>
+class when_all_state;
+
+// State of when_all, one embedded continuation slot per input.
+template <typename E, std::size_t... Is, typename... Ts>
+class when_all_state<E, std::index_sequence<Is...>, Ts...> final
+    : public async_state<std::tuple<Ts...>, E> {
+  template <std::size_t I>
+  using value_t = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+  template <std::size_t I>
+  class slot final : public async_continuation<value_t<I>, E> {
+   public:
+    when_all_state* owner = nullptr;
+
+    void run(async_state<value_t<I>, E>& source) noexcept override {
+      owner->template arrive<I>(source.take());
+    }
+  };
+
+ public:
+  when_all_state() noexcept
+      : async_state<std::tuple<Ts...>, E>(1 + sizeof...(Ts)),
+        m_remaining(sizeof...(Ts)) {
+    ((std::get<Is>(m_slots).owner = this), ...);
+  }
+
+  void attach(async_state<Ts, E>&... inputs) noexcept {
+    (inputs.attach(std::get<Is>(m_slots)), ...);
+  }
+
+ private:
+  template <std::size_t I>
+  void arrive(result<value_t<I>, E>&& outcome) noexcept {
+    if (outcome.has_value()) {
+      std::get<I>(m_values).emplace(*std::move(outcome));
+      if (m_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1 &&
+          !m_done.exchange(true, std::memory_order_acq_rel))
+        this->set(result<std::tuple<Ts...>, E>(
+            success_t,
+            std::tuple<Ts...>(std::move(*std::get<Is>(m_values))...)));
+    } else if (!m_done.exchange(true, std::memory_order_acq_rel)) {
+      this->set(outcome.has_error()
+                    ? result<std::tuple<Ts...>, E>(
+                          error_t, *std::move(outcome).error())
+                    : result<std::tuple<Ts...>, E>());
+    }
+    this->release();
+  }
+
+  std::tuple<std::optional<Ts>...> m_values;
+  std::tuple<slot<Is>...> m_slots;
+  std::atomic<std::size_t> m_remaining;
+  std::atomic<bool> m_done{false};
+};
+
+// State of when_any, one embedded continuation slot per input.
+template <typename T, typename E, std::size_t N>
+class when_any_state final : public async_state<T, E> {
+  class slot final : public async_continuation<T, E> {
+   public:
+    when_any_state* owner = nullptr;
+
+    void run(async_state<T, E>& source) noexcept override {
+      owner->arrive(source.take());
+    }
+  };
+
+ public:
+  when_any_state() noexcept : async_state<T, E>(1 + N) {
+    for (auto& s : m_slots) s.owner = this;
+  }
+
+  template <typename... Inputs>
+  void attach(Inputs&... inputs) noexcept {
+    std::size_t i = 0;
+    (inputs.attach(m_slots[i++]), ...);
+  }
+
+ private:
+  void arrive(result<T, E>&& outcome) noexcept {
+    if (!m_done.exchange(true, std::memory_order_acq_rel))
+      this->set(std::move(outcome));
+    this->release();
+  }
+
+  slot m_slots[N];
+  std::atomic<bool> m_done{false};
+};
+
+}  // namespace detail
+
+/**
+ * @brief Result that becomes available asynchronously.
+ *
+ * An async_result is a move-only handle to a shared state completed once by
+ * an async_promise or by `fst::async()`. `and_then`, `map` and `or_else`
+ * consume the handle and attach a continuation that runs on the thread
+ * completing the state, or immediately if it is already complete, and return
+ * an async_result of the continuation's outcome. No thread blocks, but each
+ * attached stage is a separate allocation holding its callable. A chain known
+ * up front is cheaper passed to `fst::async()` as a pipeline, which runs it
+ * inside the task and allocates a single state for the whole chain.
+ *
+ * Completing a state and attaching its continuation are each one atomic
+ * operation. Continuations must not throw.
+ *
+ * @tparam T The type of the success value.
+ * @tparam E The type of the error value.
+ */
+template <typename T, typename E>
+class async_result {
+ public:
+  using value_type = T;
+  using error_type = E;
+
+  /**
+   * @brief Creates an async_result that is already complete.
+   *
+   * @param outcome The result to complete with.
+   */
+  explicit async_result(result<T, E> outcome)
+      : m_state(new detail::async_state<T, E>(1)) {
+    m_state->set(std::move(outcome));
+  }
+
+  async_result(async_result&& other) noexcept
+      : m_state(std::exchange(other.m_state, nullptr)) {}
+
+  async_result& operator=(async_result&& other) noexcept {
+    if (this != &other) {
+      if (m_state) m_state->release();
+      m_state = std::exchange(other.m_state, nullptr);
+    }
+    return *this;
+  }
+
+  async_result(const async_result&) = delete;
+  async_result& operator=(const async_result&) = delete;
+
+  ~async_result() {
+    if (m_state) m_state->release();
+  }
+
+  /**
+   * @brief Checks whether the handle refers to a state, false once consumed.
+   */
+  bool valid() const noexcept { return m_state != nullptr; }
+
+  /**
+   * @brief Checks whether the result is available, false once consumed.
+   */
+  bool is_ready() const noexcept { return m_state && m_state->is_ready(); }
+
+  /**
+   * @brief Blocks until the result is available and returns it, consuming
+   * the handle.
+   *
+   * @throw bad_result_access If the handle was moved from or consumed.
+   */
+  result<T, E> get() && {
+    if (!m_state) detail::throw_async_access("async_result has no state");
+    detail::async_waiter<T, E> waiter;
+    m_state->attach(waiter);
+    waiter.wait();
+    auto outcome = m_state->take();
+    std::exchange(m_state, nullptr)->release();
+    return outcome;
+  }
+
+  /**
+   * @brief Attaches a continuation applied to the value, see
+   * result::and_then().
+   *
+   * @param f Callable with the signature `f(T) -> result<U, E>`.
+   * @return The async result of the continuation.
+   */
+  template <typename F>
+  auto and_then(F&& f) && {
+    return std::move(*this).then(
+        [f = std::forward<F>(f)](result<T, E>&& r) mutable {
+          return std::move(r).and_then(f);
+        });
+  }
+
+  /**
+   * @brief Attaches a continuation mapping the value, see result::map().
+   *
+   * @param f Callable with the signature `f(T) -> U`.
+   * @return The async result of the continuation.
+   */
+  template <typename F>
+  auto map(F&& f) && {
+    return std::move(*this).then(
+        [f = std::forward<F>(f)](result<T, E>&& r) mutable {
+          return std::move(r).map(f);
+        });
+  }
+
+  /**
+   * @brief Attaches a continuation applied to the error, see
+   * result::or_else().
+   *
+   * @param f Callable with the signature `f(E) -> result<T, U>`.
+   * @return The async result of the continuation.
+   */
+  template <typename F>
+  auto or_else(F&& f) && {
+    return std::move(*this).then(
+        [f = std::forward<F>(f)](result<T, E>&& r) mutable {
+          return std::move(r).or_else(f);
+        });
+  }
+
+  /**
+   * @brief Attaches a continuation receiving the whole result.
+   *
+   * @param f Callable with the signature `f(result<T, E>&&) -> result<U, F>`.
+   * @return The async result of the continuation.
+   * @throw bad_result_access If the handle was moved from or consumed, as do
+   * and_then(), map() and or_else().
+   */
+  template <typename F>
+  auto then(F&& f) && {
+    using stage = detail::then_state<T, E, std::decay_t<F>>;
+    if (!m_state) detail::throw_async_access("async_result has no state");
+    auto* next = new stage(std::forward<F>(f));
+    detail::async_state<T, E>* upstream = std::exchange(m_state, nullptr);
+    upstream->attach(*next);
+    upstream->release();
+    return detail::async_access::adopt(next);
+  }
+
+ private:
+  friend struct detail::async_access;
+
+  // Adopts a reference to the state.
+  explicit async_result(detail::async_state<T, E>* state) noexcept
+      : m_state(state) {}
+
+  detail::async_state<T, E>* m_state;
+};
+
+/**
+ * @brief Producer side of an async_result.
+ *
+ * A promise destroyed without being set completes its async_result with an
+ * empty result.
+ */
+template <typename T, typename E>
+class async_promise {
+ public:
+  async_promise() : m_state(new detail::async_state<T, E>(1)) {}
+
+  async_promise(async_promise&& other) noexcept
+      : m_state(std::exchange(other.m_state, nullptr)),
+        m_retrieved(other.m_retrieved),
+        m_satisfied(other.m_satisfied) {}
+
+  async_promise& operator=(async_promise&& other) noexcept {
+    if (this != &other) {
+      abandon();
+      m_state = std::exchange(other.m_state, nullptr);
+      m_retrieved = other.m_retrieved;
+      m_satisfied = other.m_satisfied;
+    }
+    return *this;
+  }
+
+  ~async_promise() { abandon(); }
+
+  /**
+   * @brief Returns the async_result completed by this promise.
+   *
+   * Only the first call returns it. Later calls, and calls after the promise
+   * has been set, return an async_result that is already complete with an
+   * empty result.
+   */
+  async_result<T, E> get_async_result() {
+    if (!m_state || std::exchange(m_retrieved, true))
+      return async_result<T, E>(result<T, E>());
+    m_state->add_ref();
+    return detail::async_access::adopt(m_state);
+  }
+
+  /**
+   * @brief Completes the async_result, running its continuation on the
+   * calling thread.
+   *
+   * @throw bad_result_access If the promise was already set ("promise
+   * already satisfied", as std::promise reports) or moved from.
+   */
+  void set(result<T, E> outcome) {
+    if (!m_state)
+      detail::throw_async_access(m_satisfied ? "promise already satisfied"
+                                             : "async_promise has no state");
+    m_state->set(std::move(outcome));
+    std::exchange(m_state, nullptr)->release();
+    m_satisfied = true;
+  }
+
+ private:
+  void abandon() noexcept {
+    if (m_state) set(result<T, E>());
+  }
+
+  detail::async_state<T, E>* m_state;
+  bool m_retrieved = false;
+  bool m_satisfied = false;
+};
+
+/**
+ * @brief Runs `f` on a thread pool and returns an async_result of its
+ * outcome.
+ *
+ * @param pool The thread pool to run on.
+ * @param f Callable with the signature `f() -> result<T, E>`, it must not
+ * throw.
+ */
+template <typename F>
+auto async(thread_pool& pool, F f) {
+  using promise_type =
+      typename detail::async_of<std::invoke_result_t<F&>>::promise;
+  // thread_pool tasks are std::function, which requires copyable callables
+  auto promise = std::make_shared<promise_type>();
+  auto outcome = promise->get_async_result();
+  pool.submit([promise, f = std::move(f)]() mutable noexcept {
+    promise->set(f());
+  });
+  return outcome;
+}
+
+/**
+ * @brief Runs `f` on a thread pool and applies `stages` to its outcome
+ * inside the same task.
+ *
+ * Equivalent to attaching the stages one by one with and_then(), map() and
+ * or_else(), but the chain is fused into the task, so its result is a single
+ * state however many stages it has:
+ *
+ * @code
+ * auto size = fst::async(pool, [] { return fetch(4); },
+ *                        fst::pipe | fst::and_then(parse) | fst::map(area));
+ * @endcode
+ *
+ * @param pool The thread pool to run on.
+ * @param f Callable with the signature `f() -> result<T, E>`, it must not
+ * throw.
+ * @param stages Callable with the signature `stages(result<T, E>&&) ->
+ * result<U, F>`, typically a fst::pipe pipeline. It must not throw.
+ */
+template <typename F, typename Stages>
+auto async(thread_pool& pool, F f, Stages stages) {
+  return async(pool, [f = std::move(f), stages = std::move(stages)]() mutable {
+    return stages(f());
+  });
+}
+
+/**
+ * @brief Combines async results into one holding a tuple of their values.
+ *
+ * Completes when every input has a value, or as soon as any input completes
+ * with an error or empty result, which is then forwarded.
+ *
+ * @throw bad_result_access If an input was moved from or consumed.
+ */
+template <typename T, typename E, typename... Ts>
+async_result<std::tuple<T, Ts...>, E> when_all(async_result<T, E> first,
+                                               async_result<Ts, E>... rest) {
+  using state = detail::when_all_state<
+      E, std::index_sequence_for<T, Ts...>, T, Ts...>;
+  // Every input is checked before the combined state is allocated
+  std::tuple<detail::async_state<T, E>&, detail::async_state<Ts, E>&...>
+      inputs(detail::async_access::state(first),
+             detail::async_access::state(rest)...);
+  auto* combined = new state();
+  std::apply([combined](auto&... input) { combined->attach(input...); },
+             inputs);
+  return detail::async_access::adopt<std::tuple<T, Ts...>, E>(combined);
+}
+
+/**
+ * @brief Returns an async result completed by whichever input completes
+ * first, with a value, an error or an empty result.
+ *
+ * @throw bad_result_access If an input was moved from or consumed.
+ */
+template <typename T, typename E, typename... Rest>
+async_result<T, E> when_any(async_result<T, E> first, Rest... rest) {
+  static_assert((std::is_same_v<Rest, async_result<T, E>> && ...),
+                "when_any requires async results of the same type");
+  using state = detail::when_any_state<T, E, 1 + sizeof...(Rest)>;
+  // Every input is checked before the combined state is allocated
+  std::tuple<detail::async_state<T, E>&,
+             detail::async_state<typename Rest::value_type, E>&...>
+      inputs(detail::async_access::state(first),
+             detail::async_access::state(rest)...);
+  auto* combined = new state();
+  std::apply([combined](auto&... input) { combined->attach(input...); },
+             inputs);
+  return detail::async_access::adopt<T, E>(combined);
+}
+
+}  // namespace fst
+
+#endif  // FST_ASYNC_RESULT_HPP
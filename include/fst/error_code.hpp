@@ -0,0 +1,191 @@
+// error_code.hpp
+#ifndef FST_ERROR_CODE_HPP
+#define FST_ERROR_CODE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace fst {
+
+// Identifier of a registered error category, 0 is never assigned.
+using error_category_id = std::uint16_t;
+
+/**
+ * @brief Entry of an error category table, mapping a code value to its
+ * message.
+ */
+struct error_code_entry {
+  std::uint16_t value;
+  std::string_view message;
+};
+
+/**
+ * @brief Static table describing an error category.
+ *
+ * Categories are meant to be defined as constexpr objects over constexpr
+ * entry tables and registered once with `register_error_category()`:
+ *
+ * @code
+ * constexpr fst::error_code_entry rpc_entries[] = {
+ *     {0, "ok"}, {1, "timeout"}, {2, "connection refused"}};
+ * constexpr fst::error_category rpc_category("rpc", rpc_entries);
+ * const fst::error_category_id rpc =
+ *     fst::register_error_category(rpc_category);
+ * @endcode
+ *
+ * Tables whose entry at index i has value i are looked up in constant time,
+ * other tables are searched linearly.
+ */
+class error_category {
+ public:
+  template <std::size_t N>
+  constexpr error_category(std::string_view name,
+                           const error_code_entry (&entries)[N]) noexcept
+      : m_name(name), m_entries(entries), m_size(N) {}
+
+  /**
+   * @brief Returns the name of the category.
+   */
+  constexpr std::string_view name() const noexcept { return m_name; }
+
+  /**
+   * @brief Returns the message of a code value, or an empty view if the table
+   * has no entry for it.
+   *
+   * @param value The code value to look up.
+   */
+  constexpr std::string_view message(std::uint16_t value) const noexcept {
+    if (value < m_size && m_entries[value].value == value)
+      return m_entries[value].message;
+    for (std::size_t i = 0; i < m_size; ++i)
+      if (m_entries[i].value == value) return m_entries[i].message;
+    return {};
+  }
+
+ private:
+  std::string_view m_name;
+  const error_code_entry* m_entries;
+  std::size_t m_size;
+};
+
+/// Maximum number of categories that can be registered.
+constexpr std::size_t max_error_categories = 255;
+
+namespace detail {
+
+// Slot 0 is reserved for the invalid id. Both arrays are constant
+// initialised, so registration from static initialisers needs no guard.
+inline std::atomic<const error_category*>
+    error_categories[max_error_categories + 1] = {};
+
+inline std::atomic<std::size_t> next_error_category{1};
+
+}  // namespace detail
+
+/**
+ * @brief Registers an error category and returns its id.
+ *
+ * Registration is lock-free and may run concurrently, typically from the
+ * initialisers of namespace-scope variables. The category must outlive every
+ * error_code referring to it.
+ *
+ * @param category The category to register.
+ * @return The id of the category, or 0 if the registry is full.
+ */
+inline error_category_id register_error_category(
+    const error_category& category) noexcept {
+  const std::size_t id =
+      detail::next_error_category.fetch_add(1, std::memory_order_relaxed);
+  if (id > max_error_categories) return 0;
+  detail::error_categories[id].store(&category, std::memory_order_release);
+  return static_cast<error_category_id>(id);
+}
+
+/**
+ * @brief Returns the registered category with the given id, or nullptr.
+ *
+ * @param id The id returned by `register_error_category()`.
+ */
+inline const error_category* find_error_category(
+    error_category_id id) noexcept {
+  return id <= max_error_categories
+             ? detail::error_categories[id].load(std::memory_order_acquire)
+             : nullptr;
+}
+
+/**
+ * @brief 32-bit error code made of a category id and a code value.
+ *
+ * An error_code is trivially copyable and carries no string, its message is
+ * resolved against the registered category table only when it is needed.
+ * `result<std::int32_t, error_code>` therefore occupies 8 bytes.
+ */
+class error_code {
+ public:
+  /**
+   * @brief Constructs an error code without category.
+   */
+  constexpr error_code() noexcept = default;
+
+  /**
+   * @brief Constructs an error code from a category id and a code value.
+   *
+   * @param category The id returned by `register_error_category()`.
+   * @param value The code value within the category.
+   */
+  constexpr error_code(error_category_id category,
+                       std::uint16_t value) noexcept
+      : m_category(category), m_value(value) {}
+
+  /**
+   * @brief Returns the category id of the error code.
+   */
+  constexpr error_category_id category_id() const noexcept {
+    return m_category;
+  }
+
+  /**
+   * @brief Returns the code value within the category.
+   */
+  constexpr std::uint16_t value() const noexcept { return m_value; }
+
+  /**
+   * @brief Returns the registered category of the error code, or nullptr.
+   */
+  const error_category* category() const noexcept {
+    return find_error_category(m_category);
+  }
+
+  /**
+   * @brief Returns the message of the error code without allocating, or
+   * "unknown error" if the category or value is not registered.
+   */
+  std::string_view message() const noexcept {
+    const error_category* category = this->category();
+    const std::string_view message =
+        category ? category->message(m_value) : std::string_view();
+    return message.empty() ? std::string_view("unknown error") : message;
+  }
+
+  friend constexpr bool operator==(const error_code& lhs,
+                                   const error_code& rhs) noexcept {
+    return lhs.m_category == rhs.m_category && lhs.m_value == rhs.m_value;
+  }
+
+  friend constexpr bool operator!=(const error_code& lhs,
+                                   const error_code& rhs) noexcept {
+    return !(lhs == rhs);
+  }
+
+ private:
+  error_category_id m_category = 0;
+  std::uint16_t m_value = 0;
+};
+
+static_assert(sizeof(error_code) == 4, "error_code must be 32 bits");
+
+}  // namespace fst
+
+#endif  // FST_ERROR_CODE_HPP
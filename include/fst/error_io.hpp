@@ -0,0 +1,61 @@
+// error_io.hpp
+#ifndef FST_ERROR_IO_HPP
+#define FST_ERROR_IO_HPP
+
+// Stream operators of the error types. The headers defining the types do not
+// depend on iostreams, include this header to stream them, on their own or
+// as the error of a result streamed with fst/result_io.hpp.
+
+#include <cstddef>
+#include <ostream>
+#include <string_view>
+
+#include "fst/error_code.hpp"
+#include "fst/error_string.hpp"
+
+namespace fst {
+
+template <typename E>
+struct indexed_error;
+
+template <typename E, std::size_t N>
+class error_list;
+
+/**
+ * @brief Streams the error code as `<category>:<value>: <message>`.
+ */
+inline std::ostream& operator<<(std::ostream& os, const error_code& code) {
+  const error_category* category = code.category();
+  return os << (category ? category->name() : std::string_view("unknown"))
+            << ':' << code.value() << ": " << code.message();
+}
+
+/**
+ * @brief Streams the text of the error string.
+ */
+inline std::ostream& operator<<(std::ostream& os, const error_string& str) {
+  return os << str.view();
+}
+
+/**
+ * @brief Streams the error as `element <index>: <error>`, see
+ * fst/algorithm.hpp.
+ */
+template <typename E>
+std::ostream& operator<<(std::ostream& os, const indexed_error<E>& e) {
+  return os << "element " << e.index << ": " << e.error;
+}
+
+/**
+ * @brief Streams the errors separated by "; ", see fst/algorithm.hpp.
+ */
+template <typename E, std::size_t N>
+std::ostream& operator<<(std::ostream& os, const error_list<E, N>& list) {
+  for (std::size_t i = 0; i < list.size(); ++i)
+    os << (i == 0 ? "" : "; ") << list[i];
+  return os;
+}
+
+}  // namespace fst
+
+#endif  // FST_ERROR_IO_HPP
@@ -0,0 +1,479 @@
+// error_message.hpp
+#ifndef FST_ERROR_MESSAGE_HPP
+#define FST_ERROR_MESSAGE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "fst/error_string.hpp"
+
+namespace fst {
+
+namespace detail {
+
+// Type-erased operations of a value captured by an error_message. Trivially
+// copyable values leave copy, move and destroy null and are copied bytewise.
+struct message_arg_ops {
+  std::size_t size;
+  void (*render)(std::ostream&, const void*);
+  void (*copy)(void*, const void*);
+  void (*move)(void*, void*) noexcept;
+  void (*destroy)(void*) noexcept;
+};
+
+template <typename T>
+struct message_arg_model {
+  static void render(std::ostream& os, const void* value) {
+    if constexpr (std::is_same_v<T, error_string>)
+      os << static_cast<const T*>(value)->view();
+    else
+      os << *static_cast<const T*>(value);
+  }
+
+  static void copy(void* dst, const void* src) {
+    ::new (dst) T(*static_cast<const T*>(src));
+  }
+
+  static void move(void* dst, void* src) noexcept {
+    ::new (dst) T(std::move(*static_cast<T*>(src)));
+    static_cast<T*>(src)->~T();
+  }
+
+  static void destroy(void* value) noexcept { static_cast<T*>(value)->~T(); }
+
+  static constexpr bool trivial = std::is_trivially_copyable_v<T>;
+
+  static constexpr message_arg_ops ops{sizeof(T), &render,
+                                       trivial ? nullptr : &copy,
+                                       trivial ? nullptr : &move,
+                                       trivial ? nullptr : &destroy};
+};
+
+// Strings are captured as error_string: `_es` literals by pointer, short text
+// inline and only long text on the heap.
+template <typename Arg, typename D = std::decay_t<Arg>>
+using message_capture_t =
+    std::conditional_t<std::is_convertible_v<const D&, std::string_view>,
+                       error_string, D>;
+
+template <typename Arg>
+message_capture_t<Arg> message_capture(Arg&& arg) {
+  if constexpr (std::is_constructible_v<message_capture_t<Arg>, Arg&&>)
+    return message_capture_t<Arg>(std::forward<Arg>(arg));
+  else
+    return error_string(std::string_view(arg));
+}
+
+}  // namespace detail
+
+/**
+ * @brief Error payload that captures a format string and its arguments and
+ * renders the text only when it is streamed or inspected.
+ *
+ * The format string must be a string literal. Each `{}` in it is replaced by
+ * the next argument, rendered with its `operator<<`; `{{` and `}}` produce
+ * literal braces. Arguments are copied into a fixed inline buffer of
+ * `capacity` bytes, strings are captured as fst::error_string so `_es`
+ * literals are referenced and short text is stored inline. Nothing is
+ * formatted while the error travels through a chain, so an error that is
+ * later discarded by `or_else` or `value_or` never pays for formatting.
+ *
+ * Context is added with `with_context()` or `fst::context()` in `map_error`
+ * and is rendered in front of the original message, separated by ": ".
+ * Context that does not fit in the remaining buffer is rendered right away
+ * and stored as an fst::error_string, folding in earlier context (and, if
+ * the original message alone fills the buffer, the whole message) until it
+ * fits. No text is ever dropped.
+ */
+class error_message {
+ public:
+  /// Size in bytes of the inline buffer holding format strings and arguments.
+  static constexpr std::size_t capacity = 120;
+
+  /**
+   * @brief Constructs an empty error message.
+   */
+  error_message() noexcept = default;
+
+  /**
+   * @brief Constructs an error message from a format string literal without
+   * arguments.
+   *
+   * @param format The format string.
+   */
+  template <std::size_t N>
+  error_message(const char (&format)[N]) noexcept {
+    append(format);
+  }
+
+  /**
+   * @brief Constructs an error message from a format string literal and the
+   * arguments to render into it.
+   *
+   * @tparam Args The types of the arguments, each must be copy constructible,
+   * streamable and aligned to at most `record_alignment`.
+   * @param format The format string.
+   * @param args The arguments, copied into the inline buffer.
+   */
+  template <std::size_t N, typename Arg, typename... Args>
+  error_message(const char (&format)[N], Arg&& arg, Args&&... args) {
+    static_assert(
+        required_size<Arg, Args...>() <= capacity,
+        "error_message arguments do not fit in the inline buffer");
+    append(format, std::forward<Arg>(arg), std::forward<Args>(args)...);
+  }
+
+  error_message(const error_message& other) : m_size(other.m_size) {
+    for (std::size_t offset = 0; offset < m_size;) {
+      const auto* ops = other.ops_at(offset);
+      std::memcpy(m_buffer + offset, other.m_buffer + offset, header_size);
+      if (ops->copy)
+        ops->copy(m_buffer + offset + header_size,
+                  other.m_buffer + offset + header_size);
+      else
+        std::memcpy(m_buffer + offset + header_size,
+                    other.m_buffer + offset + header_size, ops->size);
+      offset += record_size(ops->size);
+    }
+  }
+
+  error_message(error_message&& other) noexcept : m_size(other.m_size) {
+    take(other);
+  }
+
+  error_message& operator=(const error_message& other) {
+    if (this != &other) {
+      error_message copy(other);
+      *this = std::move(copy);
+    }
+    return *this;
+  }
+
+  error_message& operator=(error_message&& other) noexcept {
+    if (this != &other) {
+      clear();
+      m_size = other.m_size;
+      take(other);
+    }
+    return *this;
+  }
+
+  ~error_message() { clear(); }
+
+  /**
+   * @brief Appends context to the error message without formatting it.
+   *
+   * The context is rendered in front of the existing message. If it does not
+   * fit in the remaining buffer it is formatted immediately instead.
+   *
+   * @param format The format string literal of the context.
+   * @param args The arguments to render into the context.
+   * @return Reference to this error message.
+   */
+  template <std::size_t N, typename... Args>
+  error_message& with_context(const char (&format)[N], Args&&... args) & {
+    append(format, std::forward<Args>(args)...);
+    return *this;
+  }
+
+  /**
+   * @brief Rvalue overload of with_context(), returns the error message by
+   * value so it can be returned from `map_error`.
+   */
+  template <std::size_t N, typename... Args>
+  error_message&& with_context(const char (&format)[N], Args&&... args) && {
+    append(format, std::forward<Args>(args)...);
+    return std::move(*this);
+  }
+
+  /**
+   * @brief Returns the format string of the original message, or an empty
+   * view if the message is empty. Once context had to be rendered together
+   * with the original message, this is the "{}" of the rendered text.
+   */
+  std::string_view format() const noexcept {
+    return m_size == 0 ? std::string_view() : format_at(0);
+  }
+
+  /**
+   * @brief Checks whether the error message has no format string.
+   */
+  bool empty() const noexcept { return m_size == 0; }
+
+  /**
+   * @brief Renders the error message into a string.
+   */
+  std::string str() const {
+    std::ostringstream os;
+    os << *this;
+    return os.str();
+  }
+
+  /**
+   * @brief Renders the error message to an output stream.
+   */
+  friend std::ostream& operator<<(std::ostream& os,
+                                  const error_message& message) {
+    message.render(os);
+    return os;
+  }
+
+ private:
+  using render_fn = void(std::ostream&, const void*);
+
+  static constexpr std::size_t record_alignment = 8;
+  static constexpr std::size_t header_size = record_alignment;
+  static constexpr std::size_t max_segments = capacity / (2 * header_size);
+
+  static_assert(sizeof(const detail::message_arg_ops*) <= header_size &&
+                    sizeof(const char*) <= header_size,
+                "a pointer must fit in a record header");
+
+  // Format strings are stored as records without render operation.
+  static constexpr detail::message_arg_ops format_ops{sizeof(const char*),
+                                                      nullptr, nullptr,
+                                                      nullptr, nullptr};
+
+  static constexpr std::size_t record_size(std::size_t size) noexcept {
+    return header_size +
+           (size + record_alignment - 1) / record_alignment * record_alignment;
+  }
+
+  template <typename... Args>
+  static constexpr std::size_t required_size() noexcept {
+    return record_size(sizeof(const char*)) +
+           (record_size(sizeof(detail::message_capture_t<Args>)) + ... + 0);
+  }
+
+  const detail::message_arg_ops* ops_at(std::size_t offset) const noexcept {
+    const detail::message_arg_ops* ops;
+    std::memcpy(&ops, m_buffer + offset, sizeof(ops));
+    return ops;
+  }
+
+  std::string_view format_at(std::size_t offset) const noexcept {
+    const char* format;
+    std::memcpy(&format, m_buffer + offset + header_size, sizeof(format));
+    return format;
+  }
+
+  void put_header(const detail::message_arg_ops* ops) noexcept {
+    std::memcpy(m_buffer + m_size, &ops, sizeof(ops));
+  }
+
+  template <typename Arg>
+  void put_arg(Arg&& arg) {
+    using value_type = detail::message_capture_t<Arg>;
+    static_assert(alignof(value_type) <= record_alignment,
+                  "error_message arguments must be at most 8-byte aligned");
+    static_assert(std::is_copy_constructible_v<value_type> &&
+                      std::is_nothrow_move_constructible_v<value_type>,
+                  "error_message arguments must be copyable and nothrow "
+                  "movable");
+    put_header(&detail::message_arg_model<value_type>::ops);
+    ::new (m_buffer + m_size + header_size)
+        value_type(detail::message_capture(std::forward<Arg>(arg)));
+    m_size += static_cast<std::uint16_t>(record_size(sizeof(value_type)));
+  }
+
+  template <typename... Args>
+  void append(const char* format, Args&&... args) {
+    if (m_size + required_size<Args...>() > capacity) {
+      append_rendered(format, std::forward<Args>(args)...);
+      return;
+    }
+    put_header(&format_ops);
+    std::memcpy(m_buffer + m_size + header_size, &format, sizeof(format));
+    m_size += static_cast<std::uint16_t>(record_size(sizeof(format)));
+    (put_arg(std::forward<Args>(args)), ...);
+  }
+
+  // Formats context that does not fit right away and appends it as a single
+  // string argument. Earlier context is folded into that string until the
+  // record fits, the original message last.
+  template <typename... Args>
+  void append_rendered(const char* format, Args&&... args) {
+    std::ostringstream os;
+    std::apply(
+        [&](const auto&... captured) {
+          const void* values[] = {&captured..., nullptr};
+          render_fn* const renders[] = {
+              &detail::message_arg_model<
+                  std::decay_t<decltype(captured)>>::render...,
+              nullptr};
+          std::size_t next = 0;
+          render_format(os, format, [&](std::ostream& out) {
+            if (!renders[next]) return false;
+            renders[next](out, values[next]);
+            ++next;
+            return true;
+          });
+        },
+        std::make_tuple(detail::message_capture(std::forward<Args>(args))...));
+
+    constexpr std::size_t rendered_size = required_size<error_string>();
+    static_assert(rendered_size <= capacity,
+                  "a rendered context must fit in an empty buffer");
+    std::size_t segments[max_segments];
+    const std::size_t count = segment_offsets(segments);
+    std::size_t keep = count;
+    std::size_t end = m_size;
+    while (end + rendered_size > capacity) end = segments[--keep];
+
+    for (std::size_t i = count; i-- > keep;) {
+      os << ": ";
+      render_segment(os, segments[i]);
+    }
+    truncate(end);
+    append("{}", error_string(os.str()));
+  }
+
+  void take(error_message& other) noexcept {
+    for (std::size_t offset = 0; offset < m_size;) {
+      const auto* ops = other.ops_at(offset);
+      std::memcpy(m_buffer + offset, other.m_buffer + offset, header_size);
+      if (ops->move)
+        ops->move(m_buffer + offset + header_size,
+                  other.m_buffer + offset + header_size);
+      else
+        std::memcpy(m_buffer + offset + header_size,
+                    other.m_buffer + offset + header_size, ops->size);
+      offset += record_size(ops->size);
+    }
+    other.m_size = 0;
+  }
+
+  // Destroys the records from `end` on.
+  void truncate(std::size_t end) noexcept {
+    for (std::size_t offset = end; offset < m_size;) {
+      const auto* ops = ops_at(offset);
+      if (ops->destroy) ops->destroy(m_buffer + offset + header_size);
+      offset += record_size(ops->size);
+    }
+    m_size = static_cast<std::uint16_t>(end);
+  }
+
+  void clear() noexcept { truncate(0); }
+
+  // Stores the offsets of the format records in order, returns their count.
+  std::size_t segment_offsets(std::size_t (&segments)[max_segments]) const {
+    std::size_t count = 0;
+    for (std::size_t offset = 0; offset < m_size;) {
+      const auto* ops = ops_at(offset);
+      if (!ops->render) segments[count++] = offset;
+      offset += record_size(ops->size);
+    }
+    return count;
+  }
+
+  // Writes `format` to the stream, replacing each placeholder by calling
+  // `next`, which renders the next argument or returns false if there is
+  // none left.
+  template <typename Next>
+  static void render_format(std::ostream& os, std::string_view format,
+                            Next&& next) {
+    for (std::size_t i = 0; i < format.size(); ++i) {
+      const char c = format[i];
+      const bool has_next = i + 1 < format.size();
+      if (c == '{' && has_next && format[i + 1] == '{') {
+        os << '{';
+        ++i;
+      } else if (c == '}' && has_next && format[i + 1] == '}') {
+        os << '}';
+        ++i;
+      } else if (c == '{' && has_next && format[i + 1] == '}') {
+        if (!next(os)) os << "{}";
+        ++i;
+      } else {
+        os << c;
+      }
+    }
+  }
+
+  // Renders the format string of the record at `offset` followed by its
+  // arguments, returns the offset of the next format record.
+  std::size_t render_segment(std::ostream& os, std::size_t offset) const {
+    const std::string_view format = format_at(offset);
+    offset += record_size(sizeof(const char*));
+
+    render_format(os, format, [&](std::ostream& out) {
+      const auto* ops = offset < m_size ? ops_at(offset) : nullptr;
+      if (!ops || !ops->render) return false;
+      ops->render(out, m_buffer + offset + header_size);
+      offset += record_size(ops->size);
+      return true;
+    });
+
+    // Skip arguments without placeholder
+    while (offset < m_size && ops_at(offset)->render)
+      offset += record_size(ops_at(offset)->size);
+    return offset;
+  }
+
+  void render(std::ostream& os) const {
+    std::size_t segments[max_segments];
+    const std::size_t count = segment_offsets(segments);
+    for (std::size_t i = count; i-- > 0;) {
+      render_segment(os, segments[i]);
+      if (i != 0) os << ": ";
+    }
+  }
+
+  alignas(record_alignment) unsigned char m_buffer[capacity];
+  std::uint16_t m_size = 0;
+};
+
+namespace detail {
+
+// Callable returned by fst::context().
+template <std::size_t N, typename... Args>
+class message_context {
+ public:
+  template <typename... Ts>
+  message_context(const char (&format)[N], Ts&&... args)
+      : m_format(&format), m_args(message_capture(std::forward<Ts>(args))...) {}
+
+  error_message operator()(error_message error) const {
+    std::apply(
+        [&](const auto&... args) { error.with_context(*m_format, args...); },
+        m_args);
+    return error;
+  }
+
+ private:
+  const char (*m_format)[N];
+  std::tuple<Args...> m_args;
+};
+
+}  // namespace detail
+
+/**
+ * @brief Creates a callable for `map_error` that appends context to an
+ * error_message without formatting it.
+ *
+ * @code
+ * read_config(path).map_error(fst::context("while loading {}", path));
+ * @endcode
+ *
+ * @param format The format string literal of the context.
+ * @param args The arguments to render into the context, captured by value.
+ * @return A callable taking and returning an error_message.
+ */
+template <std::size_t N, typename... Args>
+auto context(const char (&format)[N], Args&&... args) {
+  return detail::message_context<N, detail::message_capture_t<Args>...>(
+      format, std::forward<Args>(args)...);
+}
+
+}  // namespace fst
+
+#endif  // FST_ERROR_MESSAGE_HPP
@@ -0,0 +1,278 @@
+// error_string.hpp
+#ifndef FST_ERROR_STRING_HPP
+#define FST_ERROR_STRING_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace fst {
+
+/**
+ * @brief Compact, mostly allocation-free string type for error payloads.
+ *
+ * An error_string occupies 24 bytes on 64-bit targets and stores its text in
+ * one of three ways:
+ *
+ * - Static text, a `"message"_es` literal from fst::literals or text passed
+ *   to `from_static`, is referenced by pointer and never copied.
+ * - Short messages of up to `inline_capacity` characters are copied into the
+ *   object itself.
+ * - Longer messages are copied to the heap.
+ *
+ * Only the last case allocates. Constructing an error_string from a character
+ * array is implicit, so `"message"` can be passed wherever an error_string is
+ * expected. The array is copied, as it may be a local buffer; only the `_es`
+ * literal and `from_static` skip the copy.
+ */
+class error_string {
+ public:
+  /// Maximum number of characters stored inline without allocating.
+  static constexpr std::size_t inline_capacity = 23;
+
+  /**
+   * @brief Constructs an empty error string.
+   */
+  error_string() noexcept { set_inline(nullptr, 0); }
+
+  /**
+   * @brief Constructs an error string holding a copy of a character array,
+   * a string literal or a buffer.
+   *
+   * Arrays of up to `inline_capacity` characters never allocate.
+   *
+   * @tparam N The size of the array.
+   * @param text The null-terminated characters to copy.
+   */
+  template <std::size_t N>
+  error_string(const char (&text)[N]) noexcept(N <= inline_capacity) {
+    const std::size_t size = bounded_length(text, N);
+    // An array that always fits inline never instantiates the heap path
+    if constexpr (N <= inline_capacity)
+      set_inline(text, size);
+    else
+      assign_copy(std::string_view(text, size));
+  }
+
+  /**
+   * @brief Constructs an error string holding a copy of the given text.
+   *
+   * @param text The text to copy, inline when short enough, on the heap
+   * otherwise.
+   */
+  error_string(std::string_view text) { assign_copy(text); }
+
+  /**
+   * @brief Constructs an error string holding a copy of the given string.
+   *
+   * @param text The string to copy.
+   */
+  error_string(const std::string& text)
+      : error_string(std::string_view(text)) {}
+
+  /**
+   * @brief Creates an error string referring to text with static storage
+   * duration without copying it. The text must outlive the error string.
+   *
+   * @param text The static text to refer to.
+   * @return An error string referring to the text.
+   */
+  static error_string from_static(std::string_view text) noexcept {
+    error_string result;
+    result.set_external(text.data(), text.size(), static_kind);
+    return result;
+  }
+
+  error_string(const error_string& other) {
+    if (other.kind() == heap_kind)
+      assign_copy(other.view());
+    else
+      std::memcpy(m_bytes, other.m_bytes, sizeof(m_bytes));
+  }
+
+  error_string(error_string&& other) noexcept {
+    std::memcpy(m_bytes, other.m_bytes, sizeof(m_bytes));
+    other.set_inline(nullptr, 0);
+  }
+
+  error_string& operator=(const error_string& other) {
+    if (this != &other) {
+      error_string copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+
+  error_string& operator=(error_string&& other) noexcept {
+    if (this != &other) {
+      release();
+      std::memcpy(m_bytes, other.m_bytes, sizeof(m_bytes));
+      other.set_inline(nullptr, 0);
+    }
+    return *this;
+  }
+
+  ~error_string() { release(); }
+
+  /**
+   * @brief Swaps the contents of two error strings without allocating.
+   *
+   * @param other The error string to swap with.
+   */
+  void swap(error_string& other) noexcept {
+    unsigned char tmp[sizeof(m_bytes)];
+    std::memcpy(tmp, m_bytes, sizeof(m_bytes));
+    std::memcpy(m_bytes, other.m_bytes, sizeof(m_bytes));
+    std::memcpy(other.m_bytes, tmp, sizeof(m_bytes));
+  }
+
+  /**
+   * @brief Returns a pointer to the characters of the error string.
+   *
+   * The characters are null-terminated unless the error string was created
+   * with `from_static` from text that is not.
+   */
+  const char* data() const noexcept {
+    return kind() == inline_kind ? reinterpret_cast<const char*>(m_bytes)
+                                 : external_data();
+  }
+
+  /**
+   * @brief Returns the number of characters in the error string.
+   */
+  std::size_t size() const noexcept {
+    return kind() == inline_kind ? inline_capacity - m_bytes[tag_index]
+                                 : external_size();
+  }
+
+  /**
+   * @brief Checks whether the error string has no characters.
+   */
+  bool empty() const noexcept { return size() == 0; }
+
+  /**
+   * @brief Returns a view of the characters of the error string.
+   */
+  std::string_view view() const noexcept { return {data(), size()}; }
+
+  /**
+   * @brief Implicit conversion to a view of the characters.
+   */
+  operator std::string_view() const noexcept { return view(); }
+
+  /**
+   * @brief Returns a std::string copy of the error string.
+   */
+  std::string str() const { return std::string(view()); }
+
+  /**
+   * @brief Checks whether the characters are referenced rather than owned.
+   */
+  bool is_static() const noexcept { return kind() == static_kind; }
+
+  /**
+   * @brief Checks whether the characters are stored inside the object.
+   */
+  bool is_inline() const noexcept { return kind() == inline_kind; }
+
+  /**
+   * @brief Checks whether the characters were copied to the heap.
+   */
+  bool is_heap() const noexcept { return kind() == heap_kind; }
+
+  friend bool operator==(const error_string& lhs,
+                         const error_string& rhs) noexcept {
+    return lhs.view() == rhs.view();
+  }
+
+  friend bool operator!=(const error_string& lhs,
+                         const error_string& rhs) noexcept {
+    return !(lhs == rhs);
+  }
+
+ private:
+  // The last byte holds the kind of storage. For inline strings it holds
+  // `inline_capacity - size`, which is zero, and therefore doubles as the
+  // terminating null, when the buffer is full. External strings store their
+  // pointer and size at the front and mark the last byte with a kind above
+  // `inline_capacity`.
+  static constexpr std::size_t tag_index = inline_capacity;
+  static constexpr unsigned char inline_kind = 0;
+  static constexpr unsigned char static_kind = 0x40;
+  static constexpr unsigned char heap_kind = 0x80;
+
+  static_assert(sizeof(const char*) + sizeof(std::size_t) <= tag_index,
+                "external representation must fit before the tag byte");
+
+  static std::size_t bounded_length(const char* text, std::size_t n) noexcept {
+    const void* end = std::memchr(text, '\0', n);
+    return end ? static_cast<std::size_t>(static_cast<const char*>(end) - text)
+               : n;
+  }
+
+  unsigned char kind() const noexcept {
+    return m_bytes[tag_index] <= inline_capacity ? inline_kind
+                                                 : m_bytes[tag_index];
+  }
+
+  const char* external_data() const noexcept {
+    const char* data;
+    std::memcpy(&data, m_bytes, sizeof(data));
+    return data;
+  }
+
+  std::size_t external_size() const noexcept {
+    std::size_t size;
+    std::memcpy(&size, m_bytes + sizeof(const char*), sizeof(size));
+    return size;
+  }
+
+  void set_inline(const char* text, std::size_t size) noexcept {
+    if (size != 0) std::memcpy(m_bytes, text, size);
+    m_bytes[size] = 0;
+    m_bytes[tag_index] = static_cast<unsigned char>(inline_capacity - size);
+  }
+
+  void set_external(const char* text, std::size_t size,
+                    unsigned char kind) noexcept {
+    std::memcpy(m_bytes, &text, sizeof(text));
+    std::memcpy(m_bytes + sizeof(text), &size, sizeof(size));
+    m_bytes[tag_index] = kind;
+  }
+
+  void assign_copy(std::string_view text) {
+    if (text.size() <= inline_capacity) {
+      set_inline(text.data(), text.size());
+      return;
+    }
+    char* heap = new char[text.size() + 1];
+    std::memcpy(heap, text.data(), text.size());
+    heap[text.size()] = '\0';
+    set_external(heap, text.size(), heap_kind);
+  }
+
+  void release() noexcept {
+    if (kind() == heap_kind) delete[] external_data();
+  }
+
+  alignas(std::size_t) unsigned char m_bytes[inline_capacity + 1];
+};
+
+namespace literals {
+
+/**
+ * @brief Creates an error string referring to a string literal without
+ * copying it, `"message"_es`.
+ */
+inline error_string operator""_es(const char* text,
+                                  std::size_t size) noexcept {
+  return error_string::from_static(std::string_view(text, size));
+}
+
+}  // namespace literals
+
+}  // namespace fst
+
+#endif  // FST_ERROR_STRING_HPP
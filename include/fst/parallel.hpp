@@ -0,0 +1,401 @@
+// parallel.hpp
+#ifndef FST_PARALLEL_HPP
+#define FST_PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "fst/algorithm.hpp"
+#include "fst/result_core.hpp"
+
+namespace fst {
+
+/**
+ * @brief Fixed-size pool of worker threads running submitted tasks in FIFO
+ * order.
+ *
+ * The parallel algorithms accept a pool so callers and tests can control the
+ * number of threads; without one they use `default_thread_pool()`.
+ */
+class thread_pool {
+ public:
+  /**
+   * @brief Starts the given number of worker threads, at least one.
+   *
+   * @param threads The number of worker threads, defaults to the number of
+   * hardware threads.
+   */
+  explicit thread_pool(
+      std::size_t threads = std::thread::hardware_concurrency()) {
+    threads = std::max<std::size_t>(threads, 1);
+    m_workers.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i)
+      m_workers.emplace_back([this] { work(); });
+  }
+
+  thread_pool(const thread_pool&) = delete;
+  thread_pool& operator=(const thread_pool&) = delete;
+
+  /**
+   * @brief Runs the remaining queued tasks and joins the worker threads.
+   */
+  ~thread_pool() {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stopping = true;
+    }
+    m_ready.notify_all();
+    for (auto& worker : m_workers) worker.join();
+  }
+
+  /**
+   * @brief Returns the number of worker threads.
+   */
+  std::size_t size() const noexcept { return m_workers.size(); }
+
+  /**
+   * @brief Queues a task to run on a worker thread.
+   *
+   * @param task The task to run, it must not throw.
+   */
+  void submit(std::function<void()> task) {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_tasks.push_back(std::move(task));
+    }
+    m_ready.notify_one();
+  }
+
+ private:
+  void work() {
+    for (;;) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_ready.wait(lock, [this] { return m_stopping || !m_tasks.empty(); });
+        if (m_tasks.empty()) return;
+        task = std::move(m_tasks.front());
+        m_tasks.pop_front();
+      }
+      task();
+    }
+  }
+
+  std::mutex m_mutex;
+  std::condition_variable m_ready;
+  std::deque<std::function<void()>> m_tasks;
+  std::vector<std::thread> m_workers;
+  bool m_stopping = false;
+};
+
+/**
+ * @brief Returns the process-wide thread pool used when no pool is given.
+ */
+inline thread_pool& default_thread_pool() {
+  static thread_pool pool;
+  return pool;
+}
+
+/**
+ * @brief Enum selecting which error a parallel algorithm reports when several
+ * elements fail.
+ */
+enum class error_order : unsigned char {
+  // The first error observed by any thread wins and all remaining work is
+  // cancelled immediately. Fastest, but the reported error may vary between
+  // runs.
+  first_observed,
+  // The error of the failing element with the lowest index wins. Work after
+  // that index is cancelled, work before it still runs, so the reported error
+  // is the same as that of a sequential loop.
+  lowest_index
+};
+
+/**
+ * @brief Options of the parallel algorithms.
+ */
+struct parallel_options {
+  // Number of elements per chunk, 0 picks about four chunks per thread.
+  std::size_t chunk_size = 0;
+  error_order order = error_order::first_observed;
+};
+
+namespace detail {
+
+// State shared by the calling thread and the helper tasks of one parallel
+// call. Helpers claim chunks until none remain; the caller claims chunks too,
+// so the call makes progress even when the pool is busy, and waits only for
+// the chunks to complete. Helpers that start after all chunks were claimed
+// return without touching `run`.
+template <typename E>
+struct parallel_state {
+  std::size_t size = 0;
+  std::size_t chunk_size = 1;
+  std::size_t chunks = 0;
+  error_order order = error_order::first_observed;
+  std::function<void(std::size_t, std::size_t, std::size_t)> run;
+
+  std::atomic<std::size_t> next_chunk{0};
+  std::atomic<std::size_t> stop_index{0};
+
+  std::mutex mutex;
+  std::condition_variable done;
+  std::size_t completed = 0;
+  bool failed = false;
+  std::size_t error_index = 0;
+  std::optional<E> error;
+  std::exception_ptr exception;
+
+  bool stopped(std::size_t index) const noexcept {
+    return index >= stop_index.load(std::memory_order_relaxed);
+  }
+
+  // Records the failure of element `index` and cancels the work it makes
+  // unnecessary.
+  void fail(std::size_t index, std::optional<E> element_error,
+            std::exception_ptr element_exception = nullptr) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const bool wins = order == error_order::lowest_index
+                          ? !failed || index < error_index
+                          : !failed;
+    if (!wins) return;
+
+    failed = true;
+    error_index = index;
+    error = std::move(element_error);
+    exception = element_exception;
+
+    const std::size_t stop = order == error_order::lowest_index ? index : 0;
+    std::size_t current = stop_index.load(std::memory_order_relaxed);
+    while (stop < current &&
+           !stop_index.compare_exchange_weak(current, stop,
+                                             std::memory_order_relaxed)) {
+    }
+  }
+
+  void run_chunks() {
+    for (;;) {
+      const std::size_t chunk =
+          next_chunk.fetch_add(1, std::memory_order_relaxed);
+      if (chunk >= chunks) return;
+
+      const std::size_t begin = chunk * chunk_size;
+      const std::size_t end = std::min(size, begin + chunk_size);
+      if (!stopped(begin)) run(chunk, begin, end);
+
+      std::lock_guard<std::mutex> lock(mutex);
+      if (++completed == chunks) done.notify_all();
+    }
+  }
+};
+
+// Number of elements per chunk, about four chunks per thread by default.
+inline std::size_t chunk_size_for(const thread_pool& pool, std::size_t size,
+                                  const parallel_options& options) noexcept {
+  return options.chunk_size != 0
+             ? options.chunk_size
+             : std::max<std::size_t>(1, size / (pool.size() * 4));
+}
+
+// Splits [0, size) into chunks, runs `run(chunk, begin, end)` for each of
+// them on the pool and the calling thread, and waits for all chunks.
+template <typename E, typename Run>
+std::shared_ptr<parallel_state<E>> run_parallel(thread_pool& pool,
+                                                std::size_t size,
+                                                const parallel_options& options,
+                                                Run&& run) {
+  auto state = std::make_shared<parallel_state<E>>();
+  state->size = size;
+  state->chunk_size = chunk_size_for(pool, size, options);
+  state->chunks = (size + state->chunk_size - 1) / state->chunk_size;
+  state->order = options.order;
+  state->stop_index.store(size, std::memory_order_relaxed);
+  state->run = [&run, raw = state.get()](std::size_t chunk, std::size_t begin,
+                                         std::size_t end) {
+#if defined(FST_NO_EXCEPTIONS)
+    run(chunk, begin, end, *raw);
+#else
+    try {
+      run(chunk, begin, end, *raw);
+    } catch (...) {
+      raw->fail(begin, std::nullopt, std::current_exception());
+    }
+#endif
+  };
+
+  if (state->chunks == 0) return state;
+
+  const std::size_t helpers = std::min(pool.size(), state->chunks - 1);
+  for (std::size_t i = 0; i < helpers; ++i)
+    pool.submit([state] { state->run_chunks(); });
+  state->run_chunks();
+
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->done.wait(lock, [&] { return state->completed == state->chunks; });
+  if (state->exception) std::rethrow_exception(state->exception);
+  return state;
+}
+
+template <typename It, typename F>
+using parallel_result_t = std::invoke_result_t<
+    F&, typename std::iterator_traits<It>::reference>;
+
+}  // namespace detail
+
+/**
+ * @brief Applies `f` to every element of [first, last) on a thread pool and
+ * collects the values in order.
+ *
+ * The range is split into chunks processed by the pool threads and the
+ * calling thread. As soon as an element fails the remaining chunks are
+ * cancelled, see error_order for which error is reported. An exception thrown
+ * by `f` cancels the call too and is rethrown on the calling thread.
+ *
+ * @param pool The thread pool to run on.
+ * @param first The beginning of the input range, random access.
+ * @param last The end of the input range.
+ * @param f Callable with the signature `f(const T&) -> result<U, E>`, called
+ * concurrently.
+ * @param options The chunk size and error order.
+ * @return The values in input order, the reported error, or an empty result if
+ * the reported element returned an empty result.
+ */
+template <typename It, typename F>
+auto parallel_transform(thread_pool& pool, It first, It last, F f,
+                        parallel_options options = {}) {
+  using element = detail::result_element<detail::parallel_result_t<It, F>>;
+  using U = typename element::value_type;
+  using E = typename element::error_type;
+  using result_type = result<std::vector<U>, E>;
+
+  // Each chunk fills its own slot, the slots are published to the calling
+  // thread when the chunks complete.
+  const auto size = static_cast<std::size_t>(std::distance(first, last));
+  std::vector<std::vector<U>> parts;
+
+  auto run = [&](std::size_t chunk, std::size_t begin, std::size_t end,
+                 detail::parallel_state<E>& state) {
+    std::vector<U> values;
+    values.reserve(end - begin);
+    for (std::size_t i = begin; i < end && !state.stopped(i); ++i) {
+      auto element = f(first[static_cast<std::ptrdiff_t>(i)]);
+      if (!element.has_value()) {
+        state.fail(i, std::move(element).error());
+        return;
+      }
+      values.push_back(*std::move(element));
+    }
+    parts[chunk] = std::move(values);
+  };
+
+  const std::size_t chunk_size = detail::chunk_size_for(pool, size, options);
+  parts.resize((size + chunk_size - 1) / chunk_size);
+
+  auto state = detail::run_parallel<E>(pool, size, options, run);
+  if (state->failed)
+    return state->error ? result_type(error_t, std::move(*state->error))
+                        : result_type();
+
+  std::vector<U> values;
+  values.reserve(size);
+  for (auto& part : parts)
+    std::move(part.begin(), part.end(), std::back_inserter(values));
+  return result_type(success_t, std::move(values));
+}
+
+/**
+ * @brief parallel_transform() on the default thread pool.
+ */
+template <typename It, typename F>
+auto parallel_transform(It first, It last, F f, parallel_options options = {}) {
+  return parallel_transform(default_thread_pool(), first, last, std::move(f),
+                            options);
+}
+
+/**
+ * @brief Applies `f` to every element of [first, last) on a thread pool and
+ * combines the values with `reducer`.
+ *
+ * Each chunk reduces its own values, the partial values are then combined
+ * with `init` in chunk order, so `reducer` must be associative but need not
+ * be commutative. Cancellation and error reporting are the same as for
+ * parallel_transform().
+ *
+ * @param pool The thread pool to run on.
+ * @param first The beginning of the input range, random access.
+ * @param last The end of the input range.
+ * @param init The initial value of the reduction.
+ * @param f Callable with the signature `f(const T&) -> result<U, E>`, called
+ * concurrently.
+ * @param reducer Callable with the signature `reducer(U, U) -> U`, called
+ * concurrently.
+ * @param options The chunk size and error order.
+ * @return The reduced value, the reported error, or an empty result if the
+ * reported element returned an empty result.
+ */
+template <typename It, typename U, typename F, typename Reducer>
+auto parallel_reduce(thread_pool& pool, It first, It last, U init, F f,
+                     Reducer reducer, parallel_options options = {}) {
+  using element = detail::result_element<detail::parallel_result_t<It, F>>;
+  using E = typename element::error_type;
+  using result_type = result<U, E>;
+
+  const auto size = static_cast<std::size_t>(std::distance(first, last));
+  std::vector<std::optional<U>> partials;
+
+  auto run = [&](std::size_t chunk, std::size_t begin, std::size_t end,
+                 detail::parallel_state<E>& state) {
+    std::optional<U> partial;
+    for (std::size_t i = begin; i < end && !state.stopped(i); ++i) {
+      auto element = f(first[static_cast<std::ptrdiff_t>(i)]);
+      if (!element.has_value()) {
+        state.fail(i, std::move(element).error());
+        return;
+      }
+      if (partial)
+        partial.emplace(reducer(std::move(*partial), *std::move(element)));
+      else
+        partial.emplace(*std::move(element));
+    }
+    partials[chunk] = std::move(partial);
+  };
+
+  const std::size_t chunk_size = detail::chunk_size_for(pool, size, options);
+  partials.resize((size + chunk_size - 1) / chunk_size);
+
+  auto state = detail::run_parallel<E>(pool, size, options, run);
+  if (state->failed)
+    return state->error ? result_type(error_t, std::move(*state->error))
+                        : result_type();
+
+  for (auto& partial : partials)
+    if (partial) init = reducer(std::move(init), std::move(*partial));
+  return result_type(success_t, std::move(init));
+}
+
+/**
+ * @brief parallel_reduce() on the default thread pool.
+ */
+template <typename It, typename U, typename F, typename Reducer>
+auto parallel_reduce(It first, It last, U init, F f, Reducer reducer,
+                     parallel_options options = {}) {
+  return parallel_reduce(default_thread_pool(), first, last, std::move(init),
+                         std::move(f), std::move(reducer), options);
+}
+
+}  // namespace fst
+
+#endif  // FST_PARALLEL_HPP
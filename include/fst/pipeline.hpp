@@ -0,0 +1,379 @@
+// pipeline.hpp
+#ifndef FST_PIPELINE_HPP
+#define FST_PIPELINE_HPP
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "fst/result_core.hpp"
+
+// The stages of a pipeline are nested calls, longer pipelines exceed the
+// inliner's growth limits unless the nesting is forced inline.
+#if defined(__GNUC__) || defined(__clang__)
+#define FST_PIPELINE_INLINE __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#define FST_PIPELINE_INLINE __forceinline
+#else
+#define FST_PIPELINE_INLINE
+#endif
+
+namespace fst {
+
+namespace detail {
+
+enum class pipe_stage_kind { and_then, map, map_error, or_else };
+
+template <typename F>
+struct and_then_stage {
+  static constexpr pipe_stage_kind kind = pipe_stage_kind::and_then;
+  F f;
+};
+
+template <typename F>
+struct map_stage {
+  static constexpr pipe_stage_kind kind = pipe_stage_kind::map;
+  F f;
+};
+
+template <typename F>
+struct map_error_stage {
+  static constexpr pipe_stage_kind kind = pipe_stage_kind::map_error;
+  F f;
+};
+
+template <typename F>
+struct or_else_stage {
+  static constexpr pipe_stage_kind kind = pipe_stage_kind::or_else;
+  F f;
+};
+
+// Stand-in for the value of a void result while it flows through a pipeline.
+struct pipe_unit {};
+
+template <typename T>
+using pipe_value_t = std::conditional_t<std::is_void_v<T>, pipe_unit, T>;
+
+template <typename T>
+using pipe_result_value_t =
+    std::conditional_t<std::is_same_v<T, pipe_unit>, void, T>;
+
+// Calls `f` with the value, or without argument for pipe_unit.
+template <typename F, typename V>
+constexpr decltype(auto) pipe_call(const F& f, V&& value) {
+  if constexpr (std::is_same_v<std::decay_t<V>, pipe_unit>)
+    return f();
+  else
+    return f(std::forward<V>(value));
+}
+
+// Calls `f` like pipe_call() and wraps a void return into pipe_unit.
+template <typename F, typename V>
+constexpr decltype(auto) pipe_map(const F& f, V&& value) {
+  if constexpr (std::is_void_v<decltype(pipe_call(f, std::declval<V>()))>) {
+    pipe_call(f, std::forward<V>(value));
+    return pipe_unit{};
+  } else {
+    return pipe_call(f, std::forward<V>(value));
+  }
+}
+
+template <typename F, typename V>
+using pipe_call_t =
+    decltype(pipe_call(std::declval<const F&>(), std::declval<V>()));
+
+// Value and error types after a stage, given the types before it.
+template <typename V, typename Err, typename Stage>
+struct pipe_step;
+
+template <typename V, typename Err, typename F>
+struct pipe_step<V, Err, and_then_stage<F>> {
+  using produced = std::decay_t<pipe_call_t<F, V>>;
+  static_assert(std::is_same_v<typename produced::error_type, Err>,
+                "and_then stages must return a result with the same error "
+                "type");
+  using value = pipe_value_t<typename produced::value_type>;
+  using error = Err;
+};
+
+template <typename V, typename Err, typename F>
+struct pipe_step<V, Err, map_stage<F>> {
+  using value = std::decay_t<decltype(pipe_map(std::declval<const F&>(),
+                                               std::declval<V>()))>;
+  using error = Err;
+};
+
+template <typename V, typename Err, typename F>
+struct pipe_step<V, Err, map_error_stage<F>> {
+  using value = V;
+  using error = std::decay_t<std::invoke_result_t<const F&, Err>>;
+};
+
+template <typename V, typename Err, typename F>
+struct pipe_step<V, Err, or_else_stage<F>> {
+  using produced = std::decay_t<std::invoke_result_t<const F&, Err>>;
+  static_assert(std::is_same_v<pipe_value_t<typename produced::value_type>, V>,
+                "or_else stages must return a result with the same value "
+                "type");
+  using value = V;
+  using error = typename produced::error_type;
+};
+
+template <typename V, typename Err, typename... Stages>
+struct pipe_fold {
+  using type = result<pipe_result_value_t<V>, Err>;
+};
+
+template <typename V, typename Err, typename Stage, typename... Rest>
+struct pipe_fold<V, Err, Stage, Rest...>
+    : pipe_fold<typename pipe_step<V, Err, Stage>::value,
+                typename pipe_step<V, Err, Stage>::error, Rest...> {};
+
+// Result type after the stages [First, First + sizeof...(Is)) of a tuple.
+template <typename V, typename Err, typename Tuple, std::size_t First,
+          typename Indices>
+struct pipe_fold_slice;
+
+template <typename V, typename Err, typename Tuple, std::size_t First,
+          std::size_t... Is>
+struct pipe_fold_slice<V, Err, Tuple, First, std::index_sequence<Is...>>
+    : pipe_fold<V, Err, std::tuple_element_t<First + Is, Tuple>...> {};
+
+// Constructs a successful result from a value, or from pipe_unit.
+template <typename R, typename V>
+FST_PIPELINE_INLINE constexpr R pipe_success(V&& value) {
+  if constexpr (std::is_void_v<typename R::value_type>)
+    return R(success_t);
+  else
+    return R(success_t, std::forward<V>(value));
+}
+
+}  // namespace detail
+
+/**
+ * @brief Lazy chain of result operations fused into a single function.
+ *
+ * A pipeline is built from `fst::pipe` and the stage functions
+ * `fst::and_then`, `fst::map`, `fst::map_error` and `fst::or_else`, and is
+ * applied to a result by calling it or with `|`:
+ *
+ * @code
+ * constexpr auto normalise = fst::pipe | fst::and_then(parse)
+ *                            | fst::map(scale) | fst::map_error(describe);
+ * fst::result<double, std::string> r = normalise(read());
+ * @endcode
+ *
+ * Unlike the equivalent chain of member calls, results are only
+ * materialised at `and_then` and `or_else` stages: the state of a result is
+ * checked once, values and errors are passed by reference through the
+ * `map` and `map_error` stages that follow, and the result returned by the
+ * next `and_then` or `or_else` stage, or the final result, is constructed
+ * directly. A value or error skipping that stage is moved into its result,
+ * so both paths join there and the code grows linearly with the number of
+ * stages. An empty result skips every stage.
+ *
+ * The stages behave like the members of the same name, except that `map`
+ * and `map_error` may change the value and error types. Stage callables are
+ * invoked as const.
+ *
+ * @tparam Stages The stages of the pipeline, in application order.
+ */
+template <typename... Stages>
+class pipeline {
+ public:
+  constexpr pipeline() = default;
+
+  constexpr explicit pipeline(std::tuple<Stages...> stages)
+      : m_stages(std::move(stages)) {}
+
+  /**
+   * @brief Applies the pipeline to a result.
+   *
+   * @param input The result to apply the stages to.
+   * @return The result of the last stage.
+   */
+  template <typename R>
+  FST_PIPELINE_INLINE constexpr auto operator()(R&& input) const {
+    using input_t = std::decay_t<R>;
+    using out = typename detail::pipe_fold<
+        detail::pipe_value_t<typename input_t::value_type>,
+        typename input_t::error_type, Stages...>::type;
+    return resume<0, out>(std::forward<R>(input));
+  }
+
+  /**
+   * @brief Appends a stage, returning the extended pipeline.
+   */
+  template <typename Stage>
+  friend constexpr pipeline<Stages..., Stage> operator|(const pipeline& lhs,
+                                                        Stage stage) {
+    return pipeline<Stages..., Stage>(
+        std::tuple_cat(lhs.m_stages, std::make_tuple(std::move(stage))));
+  }
+
+  template <typename Stage>
+  friend constexpr pipeline<Stages..., Stage> operator|(pipeline&& lhs,
+                                                        Stage stage) {
+    return pipeline<Stages..., Stage>(std::tuple_cat(
+        std::move(lhs.m_stages), std::make_tuple(std::move(stage))));
+  }
+
+  /**
+   * @brief Applies the pipeline to a result, `input | pipeline`.
+   */
+  template <typename T, typename E>
+  friend constexpr auto operator|(const result<T, E>& input,
+                                  const pipeline& p) {
+    return p(input);
+  }
+
+  template <typename T, typename E>
+  friend constexpr auto operator|(result<T, E>&& input, const pipeline& p) {
+    return p(std::move(input));
+  }
+
+ private:
+  template <std::size_t I>
+  using stage_t = std::tuple_element_t<I, std::tuple<Stages...>>;
+
+  // One past the first and_then or or_else stage from I, or the end.
+  template <std::size_t I>
+  static constexpr std::size_t segment_end() {
+    if constexpr (I == sizeof...(Stages))
+      return I;
+    else if constexpr (stage_t<I>::kind == detail::pipe_stage_kind::and_then ||
+                       stage_t<I>::kind == detail::pipe_stage_kind::or_else)
+      return I + 1;
+    else
+      return segment_end<I + 1>();
+  }
+
+  // Applies the stages from I to a result, one segment at a time.
+  template <std::size_t I, typename Out, typename R>
+  FST_PIPELINE_INLINE constexpr Out resume(R&& current) const {
+    if constexpr (I == sizeof...(Stages)) {
+      return std::forward<R>(current);
+    } else {
+      using current_t = std::decay_t<R>;
+      constexpr std::size_t end = segment_end<I>();
+      using next = typename detail::pipe_fold_slice<
+          detail::pipe_value_t<typename current_t::value_type>,
+          typename current_t::error_type, std::tuple<Stages...>, I,
+          std::make_index_sequence<end - I>>::type;
+      if constexpr (end == sizeof...(Stages))
+        return dispatch<I, next>(std::forward<R>(current));
+      else
+        return resume<end, Out>(dispatch<I, next>(std::forward<R>(current)));
+    }
+  }
+
+  // Checks the state of a result and runs the segment from I on its
+  // payload, producing the result of the segment. The empty state is tested
+  // first, it leaves the value and error paths a single test between them.
+  template <std::size_t I, typename Next, typename R>
+  FST_PIPELINE_INLINE constexpr Next dispatch(R&& current) const {
+    if (current.state() == result_state::empty) return Next();
+    if (current.has_value()) {
+      if constexpr (std::is_void_v<typename std::decay_t<R>::value_type>)
+        return run_value<I, Next>(detail::pipe_unit{});
+      else
+        return run_value<I, Next>(detail::result_payload_access::value(
+            std::forward<R>(current)));
+    }
+    return run_error<I, Next>(
+        detail::result_payload_access::error(std::forward<R>(current)));
+  }
+
+  template <std::size_t I, typename Next, typename V>
+  FST_PIPELINE_INLINE constexpr Next run_value(V&& value) const {
+    if constexpr (I == sizeof...(Stages)) {
+      return detail::pipe_success<Next>(std::forward<V>(value));
+    } else {
+      constexpr auto kind = stage_t<I>::kind;
+      const auto& f = std::get<I>(m_stages).f;
+      if constexpr (kind == detail::pipe_stage_kind::and_then)
+        return detail::pipe_call(f, std::forward<V>(value));
+      else if constexpr (kind == detail::pipe_stage_kind::map)
+        return run_value<I + 1, Next>(
+            detail::pipe_map(f, std::forward<V>(value)));
+      else if constexpr (kind == detail::pipe_stage_kind::or_else)
+        return detail::pipe_success<Next>(std::forward<V>(value));
+      else
+        return run_value<I + 1, Next>(std::forward<V>(value));
+    }
+  }
+
+  template <std::size_t I, typename Next, typename Err>
+  FST_PIPELINE_INLINE constexpr Next run_error(Err&& error) const {
+    if constexpr (I == sizeof...(Stages)) {
+      return Next(error_t, std::forward<Err>(error));
+    } else {
+      constexpr auto kind = stage_t<I>::kind;
+      const auto& f = std::get<I>(m_stages).f;
+      if constexpr (kind == detail::pipe_stage_kind::map_error)
+        return run_error<I + 1, Next>(f(std::forward<Err>(error)));
+      else if constexpr (kind == detail::pipe_stage_kind::or_else)
+        return f(std::forward<Err>(error));
+      else if constexpr (kind == detail::pipe_stage_kind::and_then)
+        return Next(error_t, std::forward<Err>(error));
+      else
+        return run_error<I + 1, Next>(std::forward<Err>(error));
+    }
+  }
+
+  std::tuple<Stages...> m_stages;
+};
+
+/**
+ * @brief Empty pipeline, the start of every pipeline expression.
+ */
+inline constexpr pipeline<> pipe{};
+
+/**
+ * @brief Pipeline stage applying `f` to the value, see result::and_then().
+ *
+ * @param f Callable with the signature `f(T) -> result<U, E>`, or `f()` for
+ * a void value.
+ */
+template <typename F>
+constexpr detail::and_then_stage<std::decay_t<F>> and_then(F&& f) {
+  return {std::forward<F>(f)};
+}
+
+/**
+ * @brief Pipeline stage mapping the value, see result::map().
+ *
+ * @param f Callable with the signature `f(T) -> U`, or `f()` for a void
+ * value.
+ */
+template <typename F>
+constexpr detail::map_stage<std::decay_t<F>> map(F&& f) {
+  return {std::forward<F>(f)};
+}
+
+/**
+ * @brief Pipeline stage mapping the error, see result::map_error().
+ *
+ * @param f Callable with the signature `f(E) -> U`.
+ */
+template <typename F>
+constexpr detail::map_error_stage<std::decay_t<F>> map_error(F&& f) {
+  return {std::forward<F>(f)};
+}
+
+/**
+ * @brief Pipeline stage applying `f` to the error, see result::or_else().
+ *
+ * @param f Callable with the signature `f(E) -> result<T, U>`.
+ */
+template <typename F>
+constexpr detail::or_else_stage<std::decay_t<F>> or_else(F&& f) {
+  return {std::forward<F>(f)};
+}
+
+}  // namespace fst
+
+#undef FST_PIPELINE_INLINE
+
+#endif  // FST_PIPELINE_HPP
@@ -0,0 +1,2771 @@
+// result_core.hpp
+#ifndef FST_RESULT_CORE_HPP
+#define FST_RESULT_CORE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <initializer_list>
+#include <new>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#if __has_include(<version>)
+#include <version>
+#endif
+
+#include "fst/result_fwd.hpp"
+
+// Destroying or replacing a payload in constant evaluation needs constexpr
+// destructors and std::construct_at, the members doing it are only constexpr
+// from C++20 on. Only then is <memory> included, payloads are otherwise
+// constructed with placement new.
+#if defined(__cpp_constexpr_dynamic_alloc) && \
+    defined(__cpp_lib_constexpr_dynamic_alloc)
+#define FST_CONSTEXPR20 constexpr
+#include <memory>
+#else
+#define FST_CONSTEXPR20
+#endif
+
+// Invalid accesses throw bad_result_access unless exceptions are disabled,
+// detected from the compiler or requested by defining FST_NO_EXCEPTIONS, in
+// which case they call the panic handler instead.
+#if !defined(FST_NO_EXCEPTIONS) && !defined(__cpp_exceptions) && \
+    !defined(_CPPUNWIND)
+#define FST_NO_EXCEPTIONS
+#endif
+
+// Failure paths of checked accesses are outlined into cold functions and the
+// success paths are marked likely, so that only a test and a call remain in
+// the code accessing the value.
+#if defined(__GNUC__) || defined(__clang__)
+#define FST_COLD __attribute__((cold, noinline))
+#define FST_LIKELY(condition) __builtin_expect(!!(condition), 1)
+#elif defined(_MSC_VER)
+#define FST_COLD __declspec(noinline)
+#define FST_LIKELY(condition) (condition)
+#else
+#define FST_COLD
+#define FST_LIKELY(condition) (condition)
+#endif
+
+namespace fst {
+
+/**
+ * @brief Enum representing the state of a result object (empty for an
+ * uninitialised result, success for a successful result and error for a
+ * failed).
+ */
+enum class result_state : unsigned char { empty, success, error };
+
+// Enum to represent the success state tag.
+enum class success_tag : unsigned char { success };
+
+// Enum to represent the error state tag.
+enum class error_tag : unsigned char { error };
+
+// Enum to represent the empty state tag.
+enum class empty_tag : unsigned char { empty };
+
+// Alias for the success tag value.
+inline constexpr success_tag success_t = success_tag::success;
+
+// Alias for the error tag value.
+inline constexpr error_tag error_t = error_tag::error;
+
+// Alias for the empty tag value.
+inline constexpr empty_tag empty_t = empty_tag::empty;
+
+// Enum to represent the in-place success construction tag.
+enum class in_place_success_tag : unsigned char { in_place_success };
+
+// Enum to represent the in-place error construction tag.
+enum class in_place_error_tag : unsigned char { in_place_error };
+
+// Alias for the in-place success tag value.
+inline constexpr in_place_success_tag in_place_success =
+    in_place_success_tag::in_place_success;
+
+// Alias for the in-place error tag value.
+inline constexpr in_place_error_tag in_place_error =
+    in_place_error_tag::in_place_error;
+
+namespace detail {
+
+// Constructs an object in place, usable in constant evaluation from C++20 on.
+template <typename X, typename... Args>
+FST_CONSTEXPR20 void construct_at(X* location, Args&&... args) {
+#if defined(__cpp_constexpr_dynamic_alloc) && \
+    defined(__cpp_lib_constexpr_dynamic_alloc)
+  std::construct_at(location, std::forward<Args>(args)...);
+#else
+  ::new (static_cast<void*>(location)) X(std::forward<Args>(args)...);
+#endif
+}
+
+// std::addressof without <memory>.
+template <typename X>
+constexpr X* address_of(X& object) noexcept {
+  return __builtin_addressof(object);
+}
+
+// Allocation-free name of a result_state.
+constexpr const char* state_name(result_state state) noexcept {
+  switch (state) {
+    case result_state::empty:
+      return "empty";
+    case result_state::success:
+      return "success";
+    case result_state::error:
+      return "error";
+    default:
+      return "unknown";
+  }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Enum representing the lifecycle events reported to a result
+ * lifecycle policy.
+ */
+enum class lifecycle_event : unsigned char {
+  construct,
+  copy,
+  move,
+  destroy,
+  state_change
+};
+
+/**
+ * @brief Compile-time lifecycle instrumentation policy for result objects.
+ *
+ * The primary template disables instrumentation: no hook is emitted and the
+ * special members of a result keep the triviality of its payloads. To route
+ * events to a sink, specialise `fst::result_lifecycle<>` once, after including
+ * this header and before any result is instantiated, with `enabled` set to
+ * true and a `static void on_event(lifecycle_event, const void*, result_state)
+ * noexcept` member. The hook receives the event, the address of the result and
+ * its state after the event. Enabling it makes the copy, move and destroy
+ * operations of every result non-trivial.
+ *
+ * Copy and move events are reported for both construction and assignment,
+ * state_change is reported in addition whenever an existing result changes
+ * state through assignment or emplacement.
+ */
+template <typename = void>
+struct result_lifecycle {
+  static constexpr bool enabled = false;
+
+  static constexpr void on_event(lifecycle_event, const void*,
+                                 result_state) noexcept {}
+};
+
+/**
+ * @brief Exception class for indicating invalid access to a result object.
+ *
+ * This exception is thrown when attempting to access the value or error of a
+ * result object in an invalid state, such as when trying to access the success
+ * value of an error result or vice versa.
+ *
+ * The exception carries the state of the accessed result and, optionally, a
+ * reason copied into a fixed-size inline buffer (truncated to
+ * max_reason_size characters), so throwing it never allocates and what()
+ * never dangles. The message for a state is picked in what() from static
+ * text.
+ */
+class bad_result_access : public std::exception {
+ public:
+  // Maximum number of characters of a reason kept by the exception.
+  static constexpr std::size_t max_reason_size = 127;
+
+  bad_result_access() noexcept {}
+
+  /**
+   * @brief Constructs the exception for an access to a result in the given
+   * state.
+   *
+   * @param state The state of the accessed result.
+   */
+  explicit bad_result_access(result_state state) noexcept
+      : m_state(state), m_has_state(true) {}
+
+  /**
+   * @brief Constructs the exception for an access to a result in the given
+   * state, with a custom reason.
+   *
+   * @param state The state of the accessed result.
+   * @param reason The reason reported by what().
+   */
+  bad_result_access(result_state state, std::string_view reason) noexcept
+      : m_state(state), m_has_state(true) {
+    set_reason(reason);
+  }
+
+  /**
+   * @brief Constructs the exception with a custom reason.
+   *
+   * @param reason The reason reported by what().
+   */
+  bad_result_access(std::string_view reason) noexcept { set_reason(reason); }
+
+  /**
+   * @brief Retrieves the state of the accessed result.
+   * @return The state of the result, or std::nullopt if it is unknown.
+   */
+  std::optional<result_state> state() const noexcept {
+    return m_has_state ? std::optional<result_state>(m_state) : std::nullopt;
+  }
+
+  const char* what() const noexcept override {
+    if (m_reason[0] != '\0') return m_reason;
+    if (!m_has_state) return "bad result access";
+    switch (m_state) {
+      case result_state::empty:
+        return "Invalid state for value access, result's state was: empty";
+      case result_state::success:
+        return "Invalid state for value access, result's state was: success";
+      case result_state::error:
+        return "Invalid state for value access, result's state was: error";
+      default:
+        return "Invalid state for value access, result's state was: unknown";
+    }
+  }
+
+ private:
+  void set_reason(std::string_view reason) noexcept {
+    const std::size_t size =
+        reason.size() < max_reason_size ? reason.size() : max_reason_size;
+    for (std::size_t i = 0; i < size; ++i) m_reason[i] = reason[i];
+    m_reason[size] = '\0';
+  }
+
+  result_state m_state = result_state::empty;
+  bool m_has_state = false;
+  char m_reason[max_reason_size + 1] = {};
+};
+
+namespace detail {
+
+#if defined(FST_NO_EXCEPTIONS)
+// Calls the installed panic handler, defined in fst/result_panic.hpp.
+[[noreturn]] inline void panic(const bad_result_access& error) noexcept;
+#endif
+
+// Reports an invalid access: throws `error`, or passes it to the panic
+// handler when exceptions are disabled.
+[[noreturn]] inline void raise_bad_result_access(
+    const bad_result_access& error) {
+#if defined(FST_NO_EXCEPTIONS)
+  panic(error);
+#else
+  throw error;
+#endif
+}
+
+// Not templates and never inlined, every call site of a checked access
+// shares one copy of the code constructing and raising the exception.
+[[noreturn]] FST_COLD inline void throw_bad_result_access() {
+  raise_bad_result_access(bad_result_access());
+}
+
+[[noreturn]] FST_COLD inline void throw_bad_result_access(result_state state) {
+  raise_bad_result_access(bad_result_access(state));
+}
+
+[[noreturn]] FST_COLD inline void throw_bad_result_access(
+    result_state state, std::string_view reason) {
+  raise_bad_result_access(bad_result_access(state, reason));
+}
+
+}  // namespace detail
+
+/**
+ * @brief Describes bits that are clear in every valid value of a type, which
+ * result can use to store its state instead of a separate state byte.
+ *
+ * When both payloads of a result are trivially copyable, have the same size
+ * and share at least two spare bits, the result is stored in a single
+ * `bits_type` and is no larger than its payloads. Specialisations provide:
+ *  - `available`: true,
+ *  - `bits_type`: an unsigned integer type of the same size as the type,
+ *  - `spare_bits`: the mask of bits that are clear in every valid value,
+ *  - `to_bits(value)` and `from_bits(bits)` converting between the two.
+ *
+ * Pointers to types aligned to at least 4 bytes and bool are provided, and
+ * enum_niche_traits can be used for enums. Specialise it for your own types
+ * to declare their spare bits. The alignment of a pointee is only known once
+ * it is complete, so a result whose payloads are both niche candidates, e.g.
+ * `result<X*, Y*>`, requires complete pointee types; a pointer paired with a
+ * payload without spare bits does not.
+ *
+ * A packed result whose success type is an enum is usable in constant
+ * expressions; one whose success type is a bool or a pointer is not.
+ *
+ * @tparam X The type being described.
+ */
+template <typename X, typename = void>
+struct niche_traits {
+  static constexpr bool available = false;
+};
+
+// Pointers to object types have their alignment bits clear. The pointee must
+// be complete, otherwise the layout of a result would depend on where it is
+// instantiated.
+template <typename X>
+struct niche_traits<X*, std::enable_if_t<std::is_object_v<X>>> {
+  static_assert(sizeof(X) > 0,
+                "niche storage of a pointer requires a complete pointee type");
+
+  static constexpr bool available = alignof(X) >= 4;
+  using bits_type = std::uintptr_t;
+  static constexpr bits_type spare_bits = alignof(X) - 1;
+
+  static bits_type to_bits(X* value) noexcept {
+    return reinterpret_cast<bits_type>(value);
+  }
+
+  static X* from_bits(bits_type bits) noexcept {
+    return reinterpret_cast<X*>(bits);
+  }
+};
+
+// Only the lowest bit of a bool is ever set.
+template <>
+struct niche_traits<bool> {
+  static constexpr bool available = true;
+  using bits_type = unsigned char;
+  static constexpr bits_type spare_bits = 0xFE;
+
+  static constexpr bits_type to_bits(bool value) noexcept {
+    return value ? 1 : 0;
+  }
+
+  static constexpr bool from_bits(bits_type bits) noexcept {
+    return bits != 0;
+  }
+};
+
+/**
+ * @brief Niche traits for an enum whose values all lie in [0, MaxValue].
+ *
+ * The bits above the highest bit of MaxValue are spare. Use it by deriving a
+ * specialisation of niche_traits from it:
+ * `template <> struct fst::niche_traits<my_enum>
+ *      : fst::enum_niche_traits<my_enum, my_enum::last> {};`
+ *
+ * @tparam Enum The enum type.
+ * @tparam MaxValue The largest enumerator of the enum.
+ */
+template <typename Enum, Enum MaxValue>
+struct enum_niche_traits {
+  static constexpr bool available = true;
+  using bits_type = std::make_unsigned_t<std::underlying_type_t<Enum>>;
+
+ private:
+  static constexpr bits_type used_bits(bits_type max) noexcept {
+    bits_type mask = 0;
+    while (max != 0) {
+      mask = static_cast<bits_type>((mask << 1) | 1);
+      max = static_cast<bits_type>(max >> 1);
+    }
+    return mask;
+  }
+
+ public:
+  static constexpr bits_type spare_bits = static_cast<bits_type>(
+      ~used_bits(static_cast<bits_type>(MaxValue)));
+
+  static constexpr bits_type to_bits(Enum value) noexcept {
+    return static_cast<bits_type>(value);
+  }
+
+  static constexpr Enum from_bits(bits_type bits) noexcept {
+    return static_cast<Enum>(bits);
+  }
+};
+
+namespace detail {
+
+// Defers the lookup of result_lifecycle<> until a result is instantiated, so
+// that the policy can be specialised after including this header.
+template <typename T, typename E>
+struct lifecycle_of {
+  using type = result_lifecycle<>;
+};
+
+template <typename T, typename E>
+using lifecycle_t = typename lifecycle_of<T, E>::type;
+
+template <typename T, typename E>
+inline constexpr bool lifecycle_enabled_v = lifecycle_t<T, E>::enabled;
+
+/**
+ * @brief Union holding either the success or the error value. It is
+ * trivially destructible whenever both payloads are, so that result<T, E>
+ * inherits the triviality of its payloads.
+ */
+template <typename T, typename E,
+          bool = std::is_trivially_destructible_v<T> &&
+                 std::is_trivially_destructible_v<E>>
+union result_union {
+  constexpr result_union() noexcept : m_empty() {}
+
+  template <typename... Args>
+  constexpr explicit result_union(success_tag, Args&&... args)
+      : m_value(std::forward<Args>(args)...) {}
+
+  template <typename... Args>
+  constexpr explicit result_union(error_tag, Args&&... args)
+      : m_error(std::forward<Args>(args)...) {}
+
+  char m_empty;
+  T m_value;
+  E m_error;
+};
+
+template <typename T, typename E>
+union result_union<T, E, false> {
+  constexpr result_union() noexcept : m_empty() {}
+
+  template <typename... Args>
+  constexpr explicit result_union(success_tag, Args&&... args)
+      : m_value(std::forward<Args>(args)...) {}
+
+  template <typename... Args>
+  constexpr explicit result_union(error_tag, Args&&... args)
+      : m_error(std::forward<Args>(args)...) {}
+
+  FST_CONSTEXPR20 ~result_union() {}
+
+  char m_empty;
+  T m_value;
+  E m_error;
+};
+
+/**
+ * @brief Storage of a result: the state and the payload union. The destructor
+ * is only user-provided when one of the payloads is not trivially
+ * destructible or when lifecycle hooks are enabled.
+ */
+template <typename T, typename E,
+          bool = std::is_trivially_destructible_v<T> &&
+                 std::is_trivially_destructible_v<E> &&
+                 !lifecycle_enabled_v<T, E>>
+struct result_storage {
+  constexpr result_storage() noexcept : m_state(result_state::empty) {
+    notify(lifecycle_event::construct);
+  }
+
+  // Creates an empty storage without reporting it, used by the copy and move
+  // layers which report their own event.
+  constexpr explicit result_storage(empty_tag) noexcept
+      : m_state(result_state::empty) {}
+
+  template <typename... Args>
+  constexpr explicit result_storage(success_tag tag, Args&&... args)
+      : m_state(result_state::success),
+        m_self(tag, std::forward<Args>(args)...) {
+    notify(lifecycle_event::construct);
+  }
+
+  template <typename... Args>
+  constexpr explicit result_storage(error_tag tag, Args&&... args)
+      : m_state(result_state::error),
+        m_self(tag, std::forward<Args>(args)...) {
+    notify(lifecycle_event::construct);
+  }
+
+  constexpr void destroy_payload() noexcept { m_state = result_state::empty; }
+
+  constexpr void notify(lifecycle_event event) const noexcept {
+    if constexpr (lifecycle_enabled_v<T, E>) {
+      lifecycle_t<T, E>::on_event(event, this, m_state);
+    }
+  }
+
+  result_state m_state;
+  result_union<T, E> m_self;
+};
+
+template <typename T, typename E>
+struct result_storage<T, E, false> {
+  constexpr result_storage() noexcept : m_state(result_state::empty) {
+    notify(lifecycle_event::construct);
+  }
+
+  // Creates an empty storage without reporting it, used by the copy and move
+  // layers which report their own event.
+  constexpr explicit result_storage(empty_tag) noexcept
+      : m_state(result_state::empty) {}
+
+  template <typename... Args>
+  constexpr explicit result_storage(success_tag tag, Args&&... args)
+      : m_state(result_state::success),
+        m_self(tag, std::forward<Args>(args)...) {
+    notify(lifecycle_event::construct);
+  }
+
+  template <typename... Args>
+  constexpr explicit result_storage(error_tag tag, Args&&... args)
+      : m_state(result_state::error),
+        m_self(tag, std::forward<Args>(args)...) {
+    notify(lifecycle_event::construct);
+  }
+
+  FST_CONSTEXPR20 ~result_storage() {
+    notify(lifecycle_event::destroy);
+    destroy_payload();
+  }
+
+  FST_CONSTEXPR20 void destroy_payload() noexcept {
+    switch (m_state) {
+      case result_state::success:
+        m_self.m_value.~T();
+        break;
+      case result_state::error:
+        m_self.m_error.~E();
+        break;
+      default:
+        break;
+    }
+    m_state = result_state::empty;
+  }
+
+  constexpr void notify(lifecycle_event event) const noexcept {
+    if constexpr (lifecycle_enabled_v<T, E>) {
+      lifecycle_t<T, E>::on_event(event, this, m_state);
+    }
+  }
+
+  result_state m_state;
+  result_union<T, E> m_self;
+};
+
+// Lowest set bit of a mask, zero if the mask is empty.
+template <typename Bits>
+constexpr Bits lowest_bit(Bits mask) noexcept {
+  return static_cast<Bits>(mask & static_cast<Bits>(~mask + 1));
+}
+
+template <typename X>
+struct niche_available : std::bool_constant<niche_traits<X>::available> {};
+
+// Checks a pointer payload last, so that its pointee only has to be complete
+// when the other payload has spare bits too.
+template <typename T, typename E>
+using niche_candidates = std::conjunction<
+    niche_available<std::conditional_t<std::is_pointer_v<T>, E, T>>,
+    niche_available<std::conditional_t<std::is_pointer_v<T>, T, E>>>;
+
+template <typename T, typename E, typename = void>
+struct niche_storable : std::false_type {};
+
+template <typename T, typename E>
+struct niche_storable<T, E, std::enable_if_t<niche_candidates<T, E>::value>>
+    : std::bool_constant<
+          std::is_same_v<typename niche_traits<T>::bits_type,
+                         typename niche_traits<E>::bits_type> &&
+          sizeof(T) == sizeof(typename niche_traits<T>::bits_type) &&
+          sizeof(E) == sizeof(typename niche_traits<E>::bits_type) &&
+          std::is_trivially_copyable_v<T> && std::is_trivially_copyable_v<E> &&
+          lowest_bit(static_cast<typename niche_traits<T>::bits_type>(
+              niche_traits<T>::spare_bits & niche_traits<E>::spare_bits &
+              ~lowest_bit(static_cast<typename niche_traits<T>::bits_type>(
+                  niche_traits<T>::spare_bits &
+                  niche_traits<E>::spare_bits)))) != 0 &&
+          !lifecycle_enabled_v<T, E>> {};
+
+template <typename T, typename E>
+inline constexpr bool niche_storable_v = niche_storable<T, E>::value;
+
+/**
+ * @brief Storage of a result whose state is packed into spare bits shared by
+ * both payloads (see niche_traits). A success value is stored as is with the
+ * spare bits clear, so it can still be referenced. An error value is stored
+ * with its lowest shared spare bit set and the empty state with the next one.
+ *
+ * An enum success type can hold every bit pattern of its underlying type, so
+ * it stays the active member in every state and the storage is usable in
+ * constant expressions. Any other success type, a bool or a pointer, makes
+ * room for the bits of an error or of the empty state, which can then only be
+ * read back through memcpy, outside of constant evaluation.
+ */
+template <typename T, typename E>
+struct result_niche_storage {
+  using bits_type = typename niche_traits<T>::bits_type;
+
+  static constexpr bits_type spare_bits = static_cast<bits_type>(
+      niche_traits<T>::spare_bits & niche_traits<E>::spare_bits);
+  static constexpr bits_type error_bit = lowest_bit(spare_bits);
+  static constexpr bits_type empty_bit =
+      lowest_bit(static_cast<bits_type>(spare_bits & ~error_bit));
+  static constexpr bool bits_in_value = std::is_enum_v<T>;
+
+  constexpr result_niche_storage() noexcept
+      : result_niche_storage(bits_tag(), empty_bit) {}
+
+  constexpr explicit result_niche_storage(empty_tag) noexcept
+      : result_niche_storage(bits_tag(), empty_bit) {}
+
+  template <typename... Args>
+  constexpr explicit result_niche_storage(success_tag, Args&&... args)
+      : m_value(std::forward<Args>(args)...) {}
+
+  template <typename... Args>
+  constexpr explicit result_niche_storage(error_tag, Args&&... args)
+      : result_niche_storage(bits_tag(),
+                             encode_error(E(std::forward<Args>(args)...))) {}
+
+  constexpr result_state get_state() const noexcept {
+    const bits_type bits = load_bits();
+    return (bits & error_bit)   ? result_state::error
+           : (bits & empty_bit) ? result_state::empty
+                                : result_state::success;
+  }
+
+  constexpr T& get_value() & noexcept { return m_value; }
+  constexpr const T& get_value() const& noexcept { return m_value; }
+  constexpr T&& get_value() && noexcept { return std::move(m_value); }
+
+  constexpr E get_error() const noexcept {
+    return niche_traits<E>::from_bits(
+        static_cast<bits_type>(load_bits() & ~error_bit));
+  }
+
+  template <typename... Args>
+  constexpr void construct_value(Args&&... args) {
+    if constexpr (bits_in_value)
+      m_value = T(std::forward<Args>(args)...);
+    else
+      ::new (static_cast<void*>(detail::address_of(m_value)))
+          T(std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  constexpr void construct_error(Args&&... args) {
+    store_bits(encode_error(E(std::forward<Args>(args)...)));
+  }
+
+  constexpr void destroy_payload() noexcept { store_bits(empty_bit); }
+
+  constexpr void notify(lifecycle_event) const noexcept {}
+
+ private:
+  struct bits_tag {};
+
+  template <bool InValue = bits_in_value, std::enable_if_t<InValue>* = nullptr>
+  constexpr result_niche_storage(bits_tag, bits_type bits) noexcept
+      : m_value(static_cast<T>(bits)) {}
+
+  template <bool InValue = bits_in_value,
+            std::enable_if_t<!InValue>* = nullptr>
+  constexpr result_niche_storage(bits_tag, bits_type bits) noexcept
+      : m_bits(bits) {}
+
+  static constexpr bits_type encode_error(const E& error) noexcept {
+    return static_cast<bits_type>(niche_traits<E>::to_bits(error) | error_bit);
+  }
+
+  // Reads the representation regardless of which member is active.
+  constexpr bits_type load_bits() const noexcept {
+    if constexpr (bits_in_value) {
+      return static_cast<bits_type>(m_value);
+    } else {
+      bits_type bits;
+      std::memcpy(&bits, static_cast<const void*>(this), sizeof(bits));
+      return bits;
+    }
+  }
+
+  constexpr void store_bits(bits_type bits) noexcept {
+    if constexpr (bits_in_value)
+      m_value = static_cast<T>(bits);
+    else
+      m_bits = bits;
+  }
+
+  union {
+    T m_value;
+    bits_type m_bits;
+  };
+};
+
+/**
+ * @brief Accessors and construction helpers on top of the state byte and
+ * payload union.
+ */
+template <typename T, typename E>
+struct result_tagged_ops : result_storage<T, E> {
+  using result_storage<T, E>::result_storage;
+
+  constexpr result_state get_state() const noexcept { return this->m_state; }
+
+  constexpr T& get_value() & noexcept { return this->m_self.m_value; }
+  constexpr const T& get_value() const& noexcept {
+    return this->m_self.m_value;
+  }
+  constexpr T&& get_value() && noexcept {
+    return std::move(this->m_self.m_value);
+  }
+
+  constexpr E& get_error() & noexcept { return this->m_self.m_error; }
+  constexpr const E& get_error() const& noexcept {
+    return this->m_self.m_error;
+  }
+  constexpr E&& get_error() && noexcept {
+    return std::move(this->m_self.m_error);
+  }
+
+  template <typename... Args>
+  FST_CONSTEXPR20 void construct_value(Args&&... args) {
+    detail::construct_at(detail::address_of(this->m_self.m_value),
+                         std::forward<Args>(args)...);
+    this->m_state = result_state::success;
+  }
+
+  template <typename... Args>
+  FST_CONSTEXPR20 void construct_error(Args&&... args) {
+    detail::construct_at(detail::address_of(this->m_self.m_error),
+                         std::forward<Args>(args)...);
+    this->m_state = result_state::error;
+  }
+};
+
+template <typename T, typename E>
+using result_access_t =
+    std::conditional_t<niche_storable_v<T, E>, result_niche_storage<T, E>,
+                       result_tagged_ops<T, E>>;
+
+/**
+ * @brief Construction and assignment helpers shared by the non-trivial copy
+ * and move layers.
+ */
+template <typename T, typename E>
+struct result_ops : result_access_t<T, E> {
+  using result_access_t<T, E>::result_access_t;
+
+  template <typename Other>
+  FST_CONSTEXPR20 void construct_from(Other&& other) {
+    switch (other.get_state()) {
+      case result_state::success:
+        this->construct_value(std::forward<Other>(other).get_value());
+        break;
+      case result_state::error:
+        this->construct_error(std::forward<Other>(other).get_error());
+        break;
+      default:
+        break;
+    }
+  }
+
+  // Basic exception guarantee: the result is left empty if constructing the
+  // new payload throws.
+  template <typename Other>
+  FST_CONSTEXPR20 void assign_from(Other&& other) {
+    constexpr lifecycle_event event = std::is_lvalue_reference_v<Other>
+                                          ? lifecycle_event::copy
+                                          : lifecycle_event::move;
+    if (this->get_state() == other.get_state()) {
+      switch (other.get_state()) {
+        case result_state::success:
+          this->get_value() = std::forward<Other>(other).get_value();
+          break;
+        case result_state::error:
+          this->get_error() = std::forward<Other>(other).get_error();
+          break;
+        default:
+          break;
+      }
+      this->notify(event);
+      return;
+    }
+    this->destroy_payload();
+    construct_from(std::forward<Other>(other));
+    this->notify(event);
+    this->notify(lifecycle_event::state_change);
+  }
+};
+
+// Copy constructor layer, trivial when both payloads are trivially copy
+// constructible.
+template <typename T, typename E,
+          bool = std::is_trivially_copy_constructible_v<T> &&
+                 std::is_trivially_copy_constructible_v<E> &&
+                 !lifecycle_enabled_v<T, E>>
+struct result_copy_base : result_ops<T, E> {
+  using result_ops<T, E>::result_ops;
+};
+
+template <typename T, typename E>
+struct result_copy_base<T, E, false> : result_ops<T, E> {
+  using result_ops<T, E>::result_ops;
+
+  result_copy_base() = default;
+  FST_CONSTEXPR20 result_copy_base(const result_copy_base& other) noexcept(
+      std::is_nothrow_copy_constructible_v<T> &&
+      std::is_nothrow_copy_constructible_v<E>)
+      : result_ops<T, E>(empty_t) {
+    this->construct_from(other);
+    this->notify(lifecycle_event::copy);
+  }
+  result_copy_base(result_copy_base&&) = default;
+  result_copy_base& operator=(const result_copy_base&) = default;
+  result_copy_base& operator=(result_copy_base&&) = default;
+};
+
+// Move constructor layer, trivial when both payloads are trivially move
+// constructible.
+template <typename T, typename E,
+          bool = std::is_trivially_move_constructible_v<T> &&
+                 std::is_trivially_move_constructible_v<E> &&
+                 !lifecycle_enabled_v<T, E>>
+struct result_move_base : result_copy_base<T, E> {
+  using result_copy_base<T, E>::result_copy_base;
+};
+
+template <typename T, typename E>
+struct result_move_base<T, E, false> : result_copy_base<T, E> {
+  using result_copy_base<T, E>::result_copy_base;
+
+  result_move_base() = default;
+  result_move_base(const result_move_base&) = default;
+  FST_CONSTEXPR20 result_move_base(result_move_base&& other) noexcept(
+      std::is_nothrow_move_constructible_v<T> &&
+      std::is_nothrow_move_constructible_v<E>)
+      : result_copy_base<T, E>(empty_t) {
+    this->construct_from(std::move(other));
+    this->notify(lifecycle_event::move);
+  }
+  result_move_base& operator=(const result_move_base&) = default;
+  result_move_base& operator=(result_move_base&&) = default;
+};
+
+// Copy assignment layer, trivial when both payloads are trivially copy
+// constructible, copy assignable and destructible.
+template <typename T, typename E,
+          bool = std::is_trivially_copy_constructible_v<T> &&
+                 std::is_trivially_copy_assignable_v<T> &&
+                 std::is_trivially_destructible_v<T> &&
+                 std::is_trivially_copy_constructible_v<E> &&
+                 std::is_trivially_copy_assignable_v<E> &&
+                 std::is_trivially_destructible_v<E> &&
+                 !lifecycle_enabled_v<T, E>>
+struct result_copy_assign_base : result_move_base<T, E> {
+  using result_move_base<T, E>::result_move_base;
+};
+
+template <typename T, typename E>
+struct result_copy_assign_base<T, E, false> : result_move_base<T, E> {
+  using result_move_base<T, E>::result_move_base;
+
+  result_copy_assign_base() = default;
+  result_copy_assign_base(const result_copy_assign_base&) = default;
+  result_copy_assign_base(result_copy_assign_base&&) = default;
+  FST_CONSTEXPR20 result_copy_assign_base& operator=(
+      const result_copy_assign_base& other) {
+    this->assign_from(other);
+    return *this;
+  }
+  result_copy_assign_base& operator=(result_copy_assign_base&&) = default;
+};
+
+// Move assignment layer, trivial when both payloads are trivially move
+// constructible, move assignable and destructible.
+template <typename T, typename E,
+          bool = std::is_trivially_move_constructible_v<T> &&
+                 std::is_trivially_move_assignable_v<T> &&
+                 std::is_trivially_destructible_v<T> &&
+                 std::is_trivially_move_constructible_v<E> &&
+                 std::is_trivially_move_assignable_v<E> &&
+                 std::is_trivially_destructible_v<E> &&
+                 !lifecycle_enabled_v<T, E>>
+struct result_move_assign_base : result_copy_assign_base<T, E> {
+  using result_copy_assign_base<T, E>::result_copy_assign_base;
+};
+
+template <typename T, typename E>
+struct result_move_assign_base<T, E, false> : result_copy_assign_base<T, E> {
+  using result_copy_assign_base<T, E>::result_copy_assign_base;
+
+  result_move_assign_base() = default;
+  result_move_assign_base(const result_move_assign_base&) = default;
+  result_move_assign_base(result_move_assign_base&&) = default;
+  result_move_assign_base& operator=(const result_move_assign_base&) = default;
+  FST_CONSTEXPR20 result_move_assign_base& operator=(
+      result_move_assign_base&& other) noexcept(
+      std::is_nothrow_move_constructible_v<T> &&
+      std::is_nothrow_move_assignable_v<T> &&
+      std::is_nothrow_move_constructible_v<E> &&
+      std::is_nothrow_move_assignable_v<E>) {
+    this->assign_from(std::move(other));
+    return *this;
+  }
+};
+
+// Deletes the copy/move constructors when a payload does not support them.
+template <bool Copy, bool Move>
+struct result_enable_ctor {};
+
+template <>
+struct result_enable_ctor<false, true> {
+  result_enable_ctor() = default;
+  result_enable_ctor(const result_enable_ctor&) = delete;
+  result_enable_ctor(result_enable_ctor&&) = default;
+  result_enable_ctor& operator=(const result_enable_ctor&) = default;
+  result_enable_ctor& operator=(result_enable_ctor&&) = default;
+};
+
+template <>
+struct result_enable_ctor<true, false> {
+  result_enable_ctor() = default;
+  result_enable_ctor(const result_enable_ctor&) = default;
+  result_enable_ctor(result_enable_ctor&&) = delete;
+  result_enable_ctor& operator=(const result_enable_ctor&) = default;
+  result_enable_ctor& operator=(result_enable_ctor&&) = default;
+};
+
+template <>
+struct result_enable_ctor<false, false> {
+  result_enable_ctor() = default;
+  result_enable_ctor(const result_enable_ctor&) = delete;
+  result_enable_ctor(result_enable_ctor&&) = delete;
+  result_enable_ctor& operator=(const result_enable_ctor&) = default;
+  result_enable_ctor& operator=(result_enable_ctor&&) = default;
+};
+
+// Deletes the copy/move assignment operators when a payload does not support
+// them.
+template <bool Copy, bool Move>
+struct result_enable_assign {};
+
+template <>
+struct result_enable_assign<false, true> {
+  result_enable_assign() = default;
+  result_enable_assign(const result_enable_assign&) = default;
+  result_enable_assign(result_enable_assign&&) = default;
+  result_enable_assign& operator=(const result_enable_assign&) = delete;
+  result_enable_assign& operator=(result_enable_assign&&) = default;
+};
+
+template <>
+struct result_enable_assign<true, false> {
+  result_enable_assign() = default;
+  result_enable_assign(const result_enable_assign&) = default;
+  result_enable_assign(result_enable_assign&&) = default;
+  result_enable_assign& operator=(const result_enable_assign&) = default;
+  result_enable_assign& operator=(result_enable_assign&&) = delete;
+};
+
+template <>
+struct result_enable_assign<false, false> {
+  result_enable_assign() = default;
+  result_enable_assign(const result_enable_assign&) = default;
+  result_enable_assign(result_enable_assign&&) = default;
+  result_enable_assign& operator=(const result_enable_assign&) = delete;
+  result_enable_assign& operator=(result_enable_assign&&) = delete;
+};
+
+template <typename T, typename E>
+using result_base = result_move_assign_base<T, E>;
+
+// Stand-in success payload of result<void, E>.
+struct void_value {};
+
+// Gives the stream operators of result_io.hpp access to the payloads.
+struct result_stream_access;
+
+// Gives the pipelines of pipeline.hpp unchecked access to the payloads of a
+// result whose state was already tested, forwarding its value category.
+struct result_payload_access {
+  template <typename R>
+  static constexpr decltype(auto) value(R&& res) noexcept {
+    if constexpr (std::is_reference_v<typename std::decay_t<R>::value_type>)
+      return *res.get_value();
+    else
+      return std::forward<R>(res).get_value();
+  }
+
+  template <typename R>
+  static constexpr decltype(auto) error(R&& res) {
+    return std::forward<R>(res).get_error();
+  }
+};
+
+template <typename T, typename E>
+using result_enable_ctor_base =
+    result_enable_ctor<std::is_copy_constructible_v<T> &&
+                           std::is_copy_constructible_v<E>,
+                       std::is_move_constructible_v<T> &&
+                           std::is_move_constructible_v<E>>;
+
+template <typename T, typename E>
+using result_enable_assign_base = result_enable_assign<
+    std::is_copy_constructible_v<T> && std::is_copy_assignable_v<T> &&
+        std::is_copy_constructible_v<E> && std::is_copy_assignable_v<E>,
+    std::is_move_constructible_v<T> && std::is_move_assignable_v<T> &&
+        std::is_move_constructible_v<E> && std::is_move_assignable_v<E>>;
+
+}  // namespace detail
+
+/**
+ * @brief Generic class that implements the monadic pattern for error handling.
+ * It can store either a successful value of type T or an error value of type E.
+ * The class includes methods for extracting the success or error values safely
+ * and handling different outcomes through chaining operations.
+ *
+ * Results are usable in constant expressions, except for results packed into
+ * the spare bits of their payloads (see niche_traits) whose success type is
+ * not an enum: `result<bool, bool>`, `result<X*, Y*>` or `result<X&, Y*>`
+ * can only be evaluated at run time.
+ *
+ * @tparam T Type of the success value.
+ * @tparam E Type of the error value.
+ */
+template <typename T, typename E>
+class result final : private detail::result_base<T, E>,
+                     private detail::result_enable_ctor_base<T, E>,
+                     private detail::result_enable_assign_base<T, E> {
+  using base = detail::result_base<T, E>;
+
+ public:
+  using value_type = T;
+  using error_type = E;
+
+  // Default constructor, creates an empty result
+  constexpr result() = default;
+
+  /**
+   * @brief Constructor for a successful result with a value.
+   *
+   * @tparam T The type of the success value.
+   * @param value The success value to be stored.
+   */
+  template <typename U = T, std::enable_if_t<!std::is_same_v<U, E>>* = nullptr>
+  constexpr result(const T& value)
+      : base(success_t, value) {}
+
+  /**
+   * @brief Constructor for a successful result, moving the value in.
+   *
+   * @tparam T The type of the success value.
+   * @param value The success value to be moved into the result.
+   */
+  template <typename U = T, std::enable_if_t<!std::is_same_v<U, E>>* = nullptr>
+  constexpr result(T&& value)
+      : base(success_t, std::move(value)) {}
+
+  /**
+   * @brief Constructor for a failed result with an error value.
+   *
+   * @tparam E The type of the error value.
+   * @param error The error value to be stored.
+   */
+  template <typename U = E, std::enable_if_t<!std::is_same_v<T, U>>* = nullptr>
+  constexpr result(const E& error)
+      : base(error_t, error) {}
+
+  /**
+   * @brief Constructor for a failed result, moving the error in.
+   *
+   * @tparam E The type of the error value.
+   * @param error The error value to be moved into the result.
+   */
+  template <typename U = E, std::enable_if_t<!std::is_same_v<T, U>>* = nullptr>
+  constexpr result(E&& error)
+      : base(error_t, std::move(error)) {}
+
+  /**
+   * @brief Constructor for a failed result from a string literal, when the
+   * error type is constructible from a character array (fst::error_string,
+   * std::string) and the success type is not.
+   *
+   * @tparam N The size of the literal, including the terminating null.
+   * @param literal The literal to construct the error value from.
+   */
+  template <std::size_t N, typename U = E,
+            std::enable_if_t<
+                std::is_constructible_v<U, const char (&)[N]> &&
+                !std::is_constructible_v<T, const char (&)[N]>>* = nullptr>
+  constexpr result(const char (&literal)[N]) : base(error_t, literal) {}
+
+  /**
+   * @brief Constructor for a successful result with a value, using a success
+   * tag.
+   *
+   * This constructor is particularly useful in cases where the type of the
+   * success value (T) is the same as the type of the error value (E) or when
+   * there might be ambiguity in type conversion.
+   *
+   * @tparam T The type of the success value.
+   * @param tag The success tag, indicating a successful result.
+   * @param value The success value to be stored.
+   */
+  constexpr result(success_tag tag, const T& value) : base(tag, value) {}
+
+  /**
+   * @brief Constructor for a successful result, moving the value in, using a
+   * success tag.
+   *
+   * @tparam T The type of the success value.
+   * @param tag The success tag, indicating a successful result.
+   * @param value The success value to be moved into the result.
+   */
+  constexpr result(success_tag tag, T&& value)
+      : base(tag, std::move(value)) {}
+
+  /**
+   * @brief Constructor for a failed result with an error value, using an error
+   * tag.
+   *
+   * This constructor is particularly useful in cases where the type of the
+   * success value (T) is the same as the type of the error value (E) or when
+   * there might be ambiguity in type conversion.
+   *
+   * @tparam E The type of the error value.
+   * @param tag The error tag, indicating an error result.
+   * @param error The error value to be stored.
+   */
+  constexpr result(error_tag tag, const E& error) : base(tag, error) {}
+
+  /**
+   * @brief Constructor for a failed result, moving the error in, using an
+   * error tag.
+   *
+   * @tparam E The type of the error value.
+   * @param tag The error tag, indicating an error result.
+   * @param error The error value to be moved into the result.
+   */
+  constexpr result(error_tag tag, E&& error) : base(tag, std::move(error)) {}
+
+  /**
+   * @brief Constructor for a successful result, constructing the value in
+   * place from the given arguments.
+   *
+   * @tparam Args The types of the arguments forwarded to T's constructor.
+   * @param args The arguments to construct the success value from.
+   */
+  template <typename... Args,
+            std::enable_if_t<std::is_constructible_v<T, Args...>>* = nullptr>
+  constexpr explicit result(in_place_success_tag, Args&&... args)
+      : base(success_t, std::forward<Args>(args)...) {}
+
+  /**
+   * @brief Constructor for a successful result, constructing the value in
+   * place from an initializer list and the given arguments.
+   *
+   * @tparam U The element type of the initializer list.
+   * @tparam Args The types of the remaining arguments.
+   * @param list The initializer list to construct the success value from.
+   * @param args The remaining arguments to construct the success value from.
+   */
+  template <typename U, typename... Args,
+            std::enable_if_t<std::is_constructible_v<
+                T, std::initializer_list<U>&, Args...>>* = nullptr>
+  constexpr explicit result(in_place_success_tag,
+                            std::initializer_list<U> list, Args&&... args)
+      : base(success_t, list, std::forward<Args>(args)...) {}
+
+  /**
+   * @brief Constructor for a failed result, constructing the error in place
+   * from the given arguments.
+   *
+   * @tparam Args The types of the arguments forwarded to E's constructor.
+   * @param args The arguments to construct the error value from.
+   */
+  template <typename... Args,
+            std::enable_if_t<std::is_constructible_v<E, Args...>>* = nullptr>
+  constexpr explicit result(in_place_error_tag, Args&&... args)
+      : base(error_t, std::forward<Args>(args)...) {}
+
+  /**
+   * @brief Constructor for a failed result, constructing the error in place
+   * from an initializer list and the given arguments.
+   *
+   * @tparam U The element type of the initializer list.
+   * @tparam Args The types of the remaining arguments.
+   * @param list The initializer list to construct the error value from.
+   * @param args The remaining arguments to construct the error value from.
+   */
+  template <typename U, typename... Args,
+            std::enable_if_t<std::is_constructible_v<
+                E, std::initializer_list<U>&, Args...>>* = nullptr>
+  constexpr explicit result(in_place_error_tag,
+                            std::initializer_list<U> list, Args&&... args)
+      : base(error_t, list, std::forward<Args>(args)...) {}
+
+  /**
+   * @brief Replaces the content of the result with a success value
+   * constructed in place from the given arguments.
+   *
+   * The current payload is destroyed first. If constructing the new value
+   * throws, the result is left empty.
+   *
+   * @tparam Args The types of the arguments forwarded to T's constructor.
+   * @param args The arguments to construct the success value from.
+   * @return A reference to the new success value.
+   */
+  template <typename... Args,
+            std::enable_if_t<std::is_constructible_v<T, Args...>>* = nullptr>
+  FST_CONSTEXPR20 T& emplace_value(Args&&... args) {
+    const result_state previous = state();
+    this->destroy_payload();
+    this->construct_value(std::forward<Args>(args)...);
+    if (previous != result_state::success)
+      this->notify(lifecycle_event::state_change);
+    return get_value();
+  }
+
+  /**
+   * @brief Replaces the content of the result with a success value
+   * constructed in place from an initializer list and the given arguments.
+   *
+   * @tparam U The element type of the initializer list.
+   * @tparam Args The types of the remaining arguments.
+   * @param list The initializer list to construct the success value from.
+   * @param args The remaining arguments to construct the success value from.
+   * @return A reference to the new success value.
+   */
+  template <typename U, typename... Args,
+            std::enable_if_t<std::is_constructible_v<
+                T, std::initializer_list<U>&, Args...>>* = nullptr>
+  FST_CONSTEXPR20 T& emplace_value(std::initializer_list<U> list,
+                                   Args&&... args) {
+    const result_state previous = state();
+    this->destroy_payload();
+    this->construct_value(list, std::forward<Args>(args)...);
+    if (previous != result_state::success)
+      this->notify(lifecycle_event::state_change);
+    return get_value();
+  }
+
+  /**
+   * @brief Replaces the content of the result with an error value
+   * constructed in place from the given arguments.
+   *
+   * The current payload is destroyed first. If constructing the new error
+   * throws, the result is left empty.
+   *
+   * @tparam Args The types of the arguments forwarded to E's constructor.
+   * @param args The arguments to construct the error value from.
+   */
+  template <typename... Args,
+            std::enable_if_t<std::is_constructible_v<E, Args...>>* = nullptr>
+  FST_CONSTEXPR20 void emplace_error(Args&&... args) {
+    const result_state previous = state();
+    this->destroy_payload();
+    this->construct_error(std::forward<Args>(args)...);
+    if (previous != result_state::error)
+      this->notify(lifecycle_event::state_change);
+  }
+
+  /**
+   * @brief Replaces the content of the result with an error value
+   * constructed in place from an initializer list and the given arguments.
+   *
+   * @tparam U The element type of the initializer list.
+   * @tparam Args The types of the remaining arguments.
+   * @param list The initializer list to construct the error value from.
+   * @param args The remaining arguments to construct the error value from.
+   */
+  template <typename U, typename... Args,
+            std::enable_if_t<std::is_constructible_v<
+                E, std::initializer_list<U>&, Args...>>* = nullptr>
+  FST_CONSTEXPR20 void emplace_error(std::initializer_list<U> list,
+                                     Args&&... args) {
+    const result_state previous = state();
+    this->destroy_payload();
+    this->construct_error(list, std::forward<Args>(args)...);
+    if (previous != result_state::error)
+      this->notify(lifecycle_event::state_change);
+  }
+
+  /**
+   * @brief Retrieves the success value if the result is in a success state.
+   * @tparam T Type of the success value.
+   * @tparam E Type of the error value.
+   * @return An optional containing the success value if available, otherwise
+   * std::nullopt.
+   */
+  [[nodiscard]] constexpr const std::optional<T> success() const& {
+    return state() == result_state::success ? std::optional<T>(get_value())
+                                            : std::nullopt;
+  }
+
+  /**
+   * @brief Moves the success value out if the result is in a success state.
+   * @return An optional containing the success value if available, otherwise
+   * std::nullopt.
+   */
+  [[nodiscard]] constexpr std::optional<T> success() && {
+    return state() == result_state::success
+               ? std::optional<T>(std::move(*this).get_value())
+               : std::nullopt;
+  }
+
+  /**
+   * @brief Retrieves the error value if the result is in an error state.
+   * @tparam T Type of the success value.
+   * @tparam E Type of the error value.
+   * @return An optional containing the error value if available, otherwise
+   * std::nullopt.
+   */
+  [[nodiscard]] constexpr const std::optional<E> error() const& {
+    return state() == result_state::error ? std::optional<E>(get_error())
+                                          : std::nullopt;
+  }
+
+  /**
+   * @brief Moves the error value out if the result is in an error state.
+   * @return An optional containing the error value if available, otherwise
+   * std::nullopt.
+   */
+  [[nodiscard]] constexpr std::optional<E> error() && {
+    return state() == result_state::error
+               ? std::optional<E>(std::move(*this).get_error())
+               : std::nullopt;
+  }
+
+  /**
+   * @brief Retrieves the success value of the result.
+   * @tparam T Type of the success value.
+   * @tparam E Type of the error value.
+   * @return The const reference to success value.
+   * @throw std::bad_result_access if result does not contain a success value.
+   */
+  [[nodiscard]] constexpr const T& value() const& {
+    if (!FST_LIKELY(state() == result_state::success))
+      detail::throw_bad_result_access(state());
+    return get_value();
+  }
+
+  /**
+   * @brief Retrieves the success value of the result for modification, e.g.
+   * to read from a stream held by the result.
+   * @return The reference to success value.
+   * @throw std::bad_result_access if result does not contain a success value.
+   */
+  [[nodiscard]] constexpr T& value() & {
+    if (!FST_LIKELY(state() == result_state::success))
+      detail::throw_bad_result_access(state());
+    return get_value();
+  }
+
+  /**
+   * @brief Moves the success value out of the result.
+   * @return The rvalue reference to success value.
+   * @throw std::bad_result_access if result does not contain a success value.
+   */
+  [[nodiscard]] constexpr T&& value() && {
+    if (!FST_LIKELY(state() == result_state::success))
+      detail::throw_bad_result_access(state());
+    return std::move(*this).get_value();
+  }
+
+  /**
+   * @brief Retrieves the success value of the result; otherwise, returns a
+   * default value.
+   * @tparam T Type of the success value.
+   * @tparam E Type of the error value.
+   * @param default_value The value to return if the result is in an error
+   * state.
+   * @return The success value if available; otherwise, the
+   * specified default value.
+   */
+  [[nodiscard]] constexpr const T value_or(
+      const T& default_value = T{}) const& {
+    return state() == result_state::success ? get_value() : default_value;
+  }
+
+  /**
+   * @brief Moves the success value out of the result; otherwise, returns a
+   * default value.
+   * @param default_value The value to return if the result is in an error
+   * state.
+   * @return The success value if available; otherwise, the
+   * specified default value.
+   */
+  [[nodiscard]] constexpr T value_or(T default_value = T{}) && {
+    return state() == result_state::success ? std::move(*this).get_value()
+                                            : std::move(default_value);
+  }
+
+  /**
+   * @brief Retrieves the success value if the result is in a success state.
+   * @tparam T Type of the success value.
+   * @tparam E Type of the error value.
+   * @param message A message to include in the exception if the result is in an
+   * error state.
+   * @return A const reference to the success value.
+   * @throw bad_result_access If the result is not in a success state,
+   * including the first bad_result_access::max_reason_size characters of the
+   * specified message. It used to be a std::runtime_error, handlers must now
+   * catch bad_result_access or std::exception.
+   */
+  [[nodiscard]] constexpr const T& expect(std::string_view message) const& {
+    if (!FST_LIKELY(state() == result_state::success))
+      detail::throw_bad_result_access(state(), message);
+    return get_value();
+  }
+
+  /**
+   * @brief Retrieves the success value for modification if the result is in a
+   * success state.
+   * @param message A message to include in the exception if the result is in an
+   * error state.
+   * @return A reference to the success value.
+   * @throw bad_result_access If the result is not in a success state,
+   * including the first bad_result_access::max_reason_size characters of the
+   * specified message. It used to be a std::runtime_error, handlers must now
+   * catch bad_result_access or std::exception.
+   */
+  [[nodiscard]] constexpr T& expect(std::string_view message) & {
+    if (!FST_LIKELY(state() == result_state::success))
+      detail::throw_bad_result_access(state(), message);
+    return get_value();
+  }
+
+  /**
+   * @brief Moves the success value out of the result if the result is in a
+   * success state.
+   * @param message A message to include in the exception if the result is in an
+   * error state.
+   * @return An rvalue reference to the success value.
+   * @throw bad_result_access If the result is not in a success state,
+   * including the first bad_result_access::max_reason_size characters of the
+   * specified message. It used to be a std::runtime_error, handlers must now
+   * catch bad_result_access or std::exception.
+   */
+  [[nodiscard]] constexpr T&& expect(std::string_view message) && {
+    if (!FST_LIKELY(state() == result_state::success))
+      detail::throw_bad_result_access(state(), message);
+    return std::move(*this).get_value();
+  }
+
+  /**
+   * @brief Retrieves the state of the result (success or error).
+   * @tparam T Type of the success value.
+   * @tparam E Type of the error value.
+   * @return The state of the result.
+   */
+  [[nodiscard]] constexpr result_state state() const {
+    return this->get_state();
+  }
+
+  /**
+   * @brief Checks if the result contains a success value.
+   * @tparam T Type of the success value.
+   * @tparam E Type of the error value.
+   * @return True if the result is in a success state; otherwise, false.
+   */
+  [[nodiscard]] constexpr bool has_value() const {
+    return state() == result_state::success;
+  }
+
+  /**
+   * @brief Checks if the result contains an error value.
+   * @tparam T Type of the success value.
+   * @tparam E Type of the error value.
+   * @return True if the result is in an error state; otherwise, false.
+   */
+  [[nodiscard]] constexpr bool has_error() const {
+    return state() == result_state::error;
+  }
+
+  /**
+   * @brief Checks if the result is empty.
+   * @tparam T Type of the success value.
+   * @tparam E Type of the error value.
+   * @return True if the result is empty; otherwise, false.
+   */
+  [[nodiscard]] constexpr bool is_empty() const {
+    return state() == result_state::empty;
+  }
+
+  /**
+   * @brief Applies the provided function to the error value if the result is
+   * in an error state, returning a new result.
+   *
+   * If the result is in a success state, returns the original success result.
+   * If the result is in an error state, applies the provided callable function
+   * to the error value and returns the result.
+   *
+   * @tparam F Type of the callable function.
+   * @param f Callable function to be applied to the error value if the result
+   * is in an error state.
+   * @return The original success result or the result of applying the callable
+   * function to the error value.
+   *
+   * @note The provided callable function must have the signature:
+   *       `auto lambda(const E& error) -> result<T, U>`,
+   *       `auto lambda(const auto& error) -> result<T, U>`,
+   *       `auto lambda(E error) -> result<T, U>` or
+   *       `auto lambda(auto error) -> result<T, U>`
+   *       where T is the original success value type and U is the desired error
+   *       value type.
+   */
+  template <typename F>
+  constexpr auto or_else(F&& f) const&
+      -> result<T, typename decltype(f(std::declval<const E&>()))::error_type> {
+    using result_t = decltype(f(std::declval<const E&>()));
+    return state() == result_state::error ? f(get_error())
+           : state() == result_state::success
+               ? result_t(success_t, get_value())
+               : result_t();
+  }
+
+  /**
+   * @brief Rvalue overload of or_else(), moves the error value into the
+   * callable function and the success value into the returned result.
+   *
+   * @tparam F Type of the callable function.
+   * @param f Callable function to be applied to the error value if the result
+   * is in an error state.
+   * @return The original success result or the result of applying the callable
+   * function to the error value.
+   */
+  template <typename F>
+  constexpr auto or_else(F&& f) &&
+      -> result<T, typename decltype(f(std::declval<E>()))::error_type> {
+    using result_t = decltype(f(std::declval<E>()));
+    return state() == result_state::error ? f(std::move(*this).get_error())
+           : state() == result_state::success
+               ? result_t(success_t, std::move(*this).get_value())
+               : result_t();
+  }
+
+  /**
+   * @brief Applies the provided callable function to the success value if the
+   * result is in a success state, returning a new result.
+   *
+   * If the result is in an error state, returns the original error result.
+   * If the result is in a success state, applies the provided callable function
+   * to the success value and returns the result.
+   *
+   * @tparam F Type of the callable function.
+   * @param f Callable function to be applied to the success value if the result
+   * is in a success state.
+   * @return The original error result or the result of applying the callable
+   * function to the success value.
+   *
+   * @note The provided callable function must have the following signatures:
+   *       `auto func(const T& value) -> result<U, E>`,
+   *       `auto func(const auto& value) -> result<U, E>`,
+   *       `auto func(T value) -> result<U, E>`, or
+   *       `auto func(auto value) -> result<U, E>`
+   *       where U is the desired success value type and E is the original error
+   *       value type.
+   */
+  template <typename F>
+  constexpr auto and_then(F&& f) const&
+      -> result<typename decltype(f(std::declval<const T&>()))::value_type, E> {
+    using result_t = decltype(f(std::declval<const T&>()));
+    return state() == result_state::success ? f(get_value())
+           : state() == result_state::error
+               ? result_t(error_t, get_error())
+               : result_t();
+  }
+
+  /**
+   * @brief Rvalue overload of and_then(), moves the success value into the
+   * callable function and the error value into the returned result.
+   *
+   * @tparam F Type of the callable function.
+   * @param f Callable function to be applied to the success value if the result
+   * is in a success state.
+   * @return The original error result or the result of applying the callable
+   * function to the success value.
+   */
+  template <typename F>
+  constexpr auto and_then(F&& f) &&
+      -> result<typename decltype(f(std::declval<T>()))::value_type, E> {
+    using result_t = decltype(f(std::declval<T>()));
+    return state() == result_state::success ? f(std::move(*this).get_value())
+           : state() == result_state::error
+               ? result_t(error_t, std::move(*this).get_error())
+               : result_t();
+  }
+
+  /**
+   * @brief Maps the success value using the provided function.
+   *
+   * If the result is in a success state, applies the provided function `f` to
+   * the success value, modifying it in place.
+   *
+   * @tparam T Type of the success value.
+   * @tparam E Type of the error value.
+   * @param f Callable function to be applied to the success value if the result
+   * is in a success state.
+   * @return Reference to the modified current result.
+   *
+   * @note The provided callable function must have the following signatures:
+   *       `auto f(const T& value) -> T` or
+   *       `auto f(const auto& value) -> T`
+   *       where T is the type of the success value.
+   */
+  template <typename F>
+  constexpr auto map(F&& f) const& {
+    return state() == result_state::success
+               ? result<T, E>(success_t, f(get_value()))
+           : state() == result_state::error
+               ? result<T, E>(error_t, get_error())
+               : result<T, E>();
+  }
+
+  /**
+   * @brief Rvalue overload of map(), moves the success value into the
+   * callable function and the error value into the returned result.
+   *
+   * @param f Callable function to be applied to the success value if the result
+   * is in a success state.
+   * @return A new result holding the mapped success value or the original
+   * error.
+   */
+  template <typename F>
+  constexpr auto map(F&& f) && {
+    return state() == result_state::success
+               ? result<T, E>(success_t, f(std::move(*this).get_value()))
+           : state() == result_state::error
+               ? result<T, E>(error_t, std::move(*this).get_error())
+               : result<T, E>();
+  }
+
+  /**
+   * @brief Maps the error value using the provided function.
+   *
+   * If the result is in an error state, applies the provided function `f` to
+   * the error value, modifying it in place.
+   *
+   * @tparam T Type of the success value.
+   * @tparam E Type of the error value.
+   * @param f Callable function to be applied to the error value if the result
+   * is in an error state.
+   * @return Reference to the modified current result.
+   *
+   * @note The provided callable function must have the following signatures:
+   *       `f(const E& error) -> E` or
+   *       `f(const auto& error) -> E`
+   *       where E is the type of the error value.
+   */
+  template <typename F>
+  constexpr auto map_error(F&& f) const& {
+    return state() == result_state::error
+               ? result<T, E>(error_t, f(get_error()))
+           : state() == result_state::success
+               ? result<T, E>(success_t, get_value())
+               : result<T, E>();
+  }
+
+  /**
+   * @brief Rvalue overload of map_error(), moves the error value into the
+   * callable function and the success value into the returned result.
+   *
+   * @param f Callable function to be applied to the error value if the result
+   * is in an error state.
+   * @return A new result holding the mapped error value or the original
+   * success value.
+   */
+  template <typename F>
+  constexpr auto map_error(F&& f) && {
+    return state() == result_state::error
+               ? result<T, E>(error_t, f(std::move(*this).get_error()))
+           : state() == result_state::success
+               ? result<T, E>(success_t, std::move(*this).get_value())
+               : result<T, E>();
+  }
+
+  /**
+   * @brief Transforms the result using the provided callable function.
+   *
+   * Applies the callable function to the current result, producing a
+   * new result based on the transformation. The transformation function is
+   * expected to take the current result as an argument and return a new result.
+   *
+   * @tparam F Type of the callable function.
+   * @param f Callable function to transform the current result.
+   * @return The result of applying the transformation function to the current
+   * result.
+   *
+   * @note The provided callable function must have the signatures:
+   *       `func(const result<T, E>& res) -> result<U, V>` or
+   *       `func(const auto& res) -> result<U, V>`,
+   *       where U is the desired success value type and V is the desired error
+   *       value type for the transformed result.
+   */
+  template <typename F>
+  constexpr auto transform(F&& f) const&
+      -> result<typename decltype(f(*this))::value_type,
+                typename decltype(f(*this))::error_type> {
+    return f(*this);
+  }
+
+  /**
+   * @brief Rvalue overload of transform(), moves the current result into the
+   * callable function.
+   *
+   * @param f Callable function to transform the current result, may take the
+   * result by value or by rvalue reference.
+   * @return The result of applying the transformation function to the current
+   * result.
+   */
+  template <typename F>
+  constexpr auto transform(F&& f) &&
+      -> result<typename decltype(f(std::move(*this)))::value_type,
+                typename decltype(f(std::move(*this)))::error_type> {
+    return f(std::move(*this));
+  }
+
+  /**
+   * @brief Invokes a callable function on the current result without modifying
+   * it.
+   *
+   * This function calls the provided function `f` with a constant reference to
+   * the current result without modifying it. It is designed for cases where
+   * side effects are intended without altering the result.
+   *
+   * @param f A function that takes a constant reference to the result.
+   *          The function should have the signatures:
+   *          `void f(const result<T,E>& res)` or
+   *          `void f(const auto& res)`.
+   *
+   * @return A copy of the unmodified current result after invoking the
+   * function.
+   */
+  template <typename F>
+  constexpr result<T, E> inspect(F&& f) const& {
+    f(*this);
+    return *this;
+  }
+
+  /**
+   * @brief Rvalue overload of inspect(), moves the current result into the
+   * returned result after invoking the function.
+   *
+   * @param f A function that takes a constant reference to the result.
+   * @return The unmodified current result after invoking the function.
+   */
+  template <typename F>
+  constexpr result<T, E> inspect(F&& f) && {
+    f(static_cast<const result<T, E>&>(*this));
+    return std::move(*this);
+  }
+
+  /**
+   * @brief Explicit conversion to bool.
+   * @return True if the result is in a success state; otherwise, false.
+   */
+  constexpr explicit operator bool() const {
+    return state() == result_state::success;
+  }
+
+  /**
+   * @brief Dereference operator.
+   * @return Const reference to the success value.
+   * @throw bad_result_access If the result is not in a success state.
+   */
+  constexpr const T& operator*() const& { return value(); }
+
+  /**
+   * @brief Dereference operator.
+   * @return Reference to the success value.
+   * @throw bad_result_access If the result is not in a success state.
+   */
+  constexpr T& operator*() & { return value(); }
+
+  /**
+   * @brief Dereference operator, moving the success value out.
+   * @return Rvalue reference to the success value.
+   * @throw bad_result_access If the result is not in a success state.
+   */
+  constexpr T&& operator*() && { return std::move(*this).value(); }
+
+  /**
+   * @brief Converts the result to a different result type, mapping the success
+   * value with the provided conversion function.
+   * @tparam U Type of the success value in the new result.
+   * @tparam E Type of the error value in the original result.
+   * @return A new result with the success value converted to type U.
+   */
+  template <typename U>
+  constexpr operator result<U, E>() const& {
+    return state() == result_state::success
+               ? result<U, E>(success_t, U(get_value()))
+           : state() == result_state::error
+               ? result<U, E>(error_t, get_error())
+               : result<U, E>();
+  }
+
+  /**
+   * @brief Converts the result to a different result type, moving the success
+   * value into the conversion and the error value into the new result.
+   * @tparam U Type of the success value in the new result.
+   * @return A new result with the success value converted to type U.
+   */
+  template <typename U>
+  constexpr operator result<U, E>() && {
+    return state() == result_state::success
+               ? result<U, E>(success_t, U(std::move(*this).get_value()))
+           : state() == result_state::error
+               ? result<U, E>(error_t, std::move(*this).get_error())
+               : result<U, E>();
+  }
+
+  /**
+   * @brief Converts the result to a different result type, mapping the error
+   * value with the provided conversion function.
+   * @tparam T Type of the success value in the original result.
+   * @tparam U Type of the error value in the new result.
+   * @return A new result with the error value converted to type E.
+   */
+  template <typename U>
+  constexpr operator result<T, U>() const& {
+    return state() == result_state::error
+               ? result<T, U>(error_t, U(get_error()))
+           : state() == result_state::success
+               ? result<T, U>(success_t, get_value())
+               : result<T, U>();
+  }
+
+  /**
+   * @brief Converts the result to a different result type, moving the error
+   * value into the conversion and the success value into the new result.
+   * @tparam U Type of the error value in the new result.
+   * @return A new result with the error value converted to type U.
+   */
+  template <typename U>
+  constexpr operator result<T, U>() && {
+    return state() == result_state::error
+               ? result<T, U>(error_t, U(std::move(*this).get_error()))
+           : state() == result_state::success
+               ? result<T, U>(success_t, std::move(*this).get_value())
+               : result<T, U>();
+  }
+
+ private:
+  friend struct detail::result_payload_access;
+  friend struct detail::result_stream_access;
+
+  using base::get_error;
+  using base::get_value;
+};
+
+
+/**
+ * @brief Specialisation of result for operations that succeed without
+ * producing a value. It stores only the error value and the state.
+ *
+ * @tparam E Type of the error value.
+ */
+template <typename E>
+class result<void, E> final
+    : private detail::result_base<detail::void_value, E>,
+      private detail::result_enable_ctor_base<detail::void_value, E>,
+      private detail::result_enable_assign_base<detail::void_value, E> {
+  using base = detail::result_base<detail::void_value, E>;
+
+ public:
+  using value_type = void;
+  using error_type = E;
+
+  // Default constructor, creates an empty result
+  constexpr result() = default;
+
+  /**
+   * @brief Constructor for a successful result.
+   *
+   * @param tag The success tag, indicating a successful result.
+   */
+  constexpr result(success_tag tag) : base(tag) {}
+
+  /**
+   * @brief Constructor for a successful result.
+   *
+   */
+  constexpr explicit result(in_place_success_tag)
+      : base(success_t) {}
+
+  /**
+   * @brief Constructor for a failed result with an error value.
+   *
+   * @param error The error value to be stored.
+   */
+  constexpr result(const E& error) : base(error_t, error) {}
+
+  /**
+   * @brief Constructor for a failed result, moving the error in.
+   *
+   * @param error The error value to be moved into the result.
+   */
+  constexpr result(E&& error) : base(error_t, std::move(error)) {}
+
+  /**
+   * @brief Constructor for a failed result from a string literal, when the
+   * error type is constructible from a character array (fst::error_string,
+   * std::string).
+   *
+   * @tparam N The size of the literal, including the terminating null.
+   * @param literal The literal to construct the error value from.
+   */
+  template <std::size_t N, typename U = E,
+            std::enable_if_t<
+                std::is_constructible_v<U, const char (&)[N]>>* = nullptr>
+  constexpr result(const char (&literal)[N]) : base(error_t, literal) {}
+
+  /**
+   * @brief Constructor for a failed result with an error value, using an error
+   * tag.
+   *
+   * @param tag The error tag, indicating an error result.
+   * @param error The error value to be stored.
+   */
+  constexpr result(error_tag tag, const E& error) : base(tag, error) {}
+
+  /**
+   * @brief Constructor for a failed result, moving the error in, using an
+   * error tag.
+   *
+   * @param tag The error tag, indicating an error result.
+   * @param error The error value to be moved into the result.
+   */
+  constexpr result(error_tag tag, E&& error) : base(tag, std::move(error)) {}
+
+  /**
+   * @brief Constructor for a failed result, constructing the error in place
+   * from the given arguments.
+   *
+   * @tparam Args The types of the arguments forwarded to E's constructor.
+   * @param args The arguments to construct the error value from.
+   */
+  template <typename... Args,
+            std::enable_if_t<std::is_constructible_v<E, Args...>>* = nullptr>
+  constexpr explicit result(in_place_error_tag, Args&&... args)
+      : base(error_t, std::forward<Args>(args)...) {}
+
+  /**
+   * @brief Replaces the content of the result with a success.
+   */
+  FST_CONSTEXPR20 void emplace_value() {
+    const result_state previous = state();
+    this->destroy_payload();
+    this->construct_value();
+    if (previous != result_state::success)
+      this->notify(lifecycle_event::state_change);
+  }
+
+  /**
+   * @brief Replaces the content of the result with an error value
+   * constructed in place from the given arguments.
+   *
+   * @tparam Args The types of the arguments forwarded to E's constructor.
+   * @param args The arguments to construct the error value from.
+   */
+  template <typename... Args,
+            std::enable_if_t<std::is_constructible_v<E, Args...>>* = nullptr>
+  FST_CONSTEXPR20 void emplace_error(Args&&... args) {
+    const result_state previous = state();
+    this->destroy_payload();
+    this->construct_error(std::forward<Args>(args)...);
+    if (previous != result_state::error)
+      this->notify(lifecycle_event::state_change);
+  }
+
+  /**
+   * @brief Retrieves the error value if the result is in an error state.
+   * @return An optional containing the error value if available, otherwise
+   * std::nullopt.
+   */
+  [[nodiscard]] constexpr const std::optional<E> error() const& {
+    return state() == result_state::error ? std::optional<E>(get_error())
+                                          : std::nullopt;
+  }
+
+  /**
+   * @brief Moves the error value out if the result is in an error state.
+   * @return An optional containing the error value if available, otherwise
+   * std::nullopt.
+   */
+  [[nodiscard]] constexpr std::optional<E> error() && {
+    return state() == result_state::error
+               ? std::optional<E>(std::move(*this).get_error())
+               : std::nullopt;
+  }
+
+  /**
+   * @brief Checks that the result is in a success state.
+   * @throw std::bad_result_access if result is not in a success state.
+   */
+  constexpr void value() const {
+    if (!FST_LIKELY(state() == result_state::success))
+      detail::throw_bad_result_access(state());
+  }
+
+  /**
+   * @brief Checks that the result is in a success state.
+   * @param message A message to include in the exception if the result is in an
+   * error state.
+   * @throw bad_result_access If the result is not in a success state,
+   * including the first bad_result_access::max_reason_size characters of the
+   * specified message. It used to be a std::runtime_error, handlers must now
+   * catch bad_result_access or std::exception.
+   */
+  constexpr void expect(std::string_view message) const {
+    if (!FST_LIKELY(state() == result_state::success))
+      detail::throw_bad_result_access(state(), message);
+  }
+
+  /**
+   * @brief Retrieves the state of the result (success or error).
+   * @return The state of the result.
+   */
+  [[nodiscard]] constexpr result_state state() const {
+    return this->get_state();
+  }
+
+  /**
+   * @brief Checks if the result is in a success state.
+   * @return True if the result is in a success state; otherwise, false.
+   */
+  [[nodiscard]] constexpr bool has_value() const {
+    return state() == result_state::success;
+  }
+
+  /**
+   * @brief Checks if the result contains an error value.
+   * @return True if the result is in an error state; otherwise, false.
+   */
+  [[nodiscard]] constexpr bool has_error() const {
+    return state() == result_state::error;
+  }
+
+  /**
+   * @brief Checks if the result is empty.
+   * @return True if the result is empty; otherwise, false.
+   */
+  [[nodiscard]] constexpr bool is_empty() const {
+    return state() == result_state::empty;
+  }
+
+  /**
+   * @brief Applies the provided function to the error value if the result is
+   * in an error state, returning a new result.
+   *
+   * @param f Callable function to be applied to the error value if the result
+   * is in an error state.
+   * @return The original success result or the result of applying the callable
+   * function to the error value.
+   *
+   * @note The provided callable function must have the signature:
+   *       `auto lambda(const E& error) -> result<void, U>`.
+   */
+  template <typename F>
+  constexpr auto or_else(F&& f) const&
+      -> result<void,
+                typename decltype(f(std::declval<const E&>()))::error_type> {
+    using result_t = decltype(f(std::declval<const E&>()));
+    return state() == result_state::error     ? f(get_error())
+           : state() == result_state::success ? result_t(success_t)
+                                              : result_t();
+  }
+
+  /**
+   * @brief Rvalue overload of or_else(), moves the error value into the
+   * callable function.
+   */
+  template <typename F>
+  constexpr auto or_else(F&& f) &&
+      -> result<void, typename decltype(f(std::declval<E>()))::error_type> {
+    using result_t = decltype(f(std::declval<E>()));
+    return state() == result_state::error ? f(std::move(*this).get_error())
+           : state() == result_state::success ? result_t(success_t)
+                                              : result_t();
+  }
+
+  /**
+   * @brief Invokes the provided callable function if the result is in a
+   * success state, returning its result.
+   *
+   * @param f Callable function invoked without arguments if the result is in a
+   * success state.
+   * @return The original error result or the result of the callable function.
+   *
+   * @note The provided callable function must have the signature:
+   *       `auto func() -> result<U, E>`.
+   */
+  template <typename F>
+  constexpr auto and_then(F&& f) const&
+      -> result<typename decltype(f())::value_type, E> {
+    using result_t = decltype(f());
+    return state() == result_state::success ? f()
+           : state() == result_state::error ? result_t(error_t, get_error())
+                                            : result_t();
+  }
+
+  /**
+   * @brief Rvalue overload of and_then(), moves the error value into the
+   * returned result.
+   */
+  template <typename F>
+  constexpr auto and_then(F&& f) &&
+      -> result<typename decltype(f())::value_type, E> {
+    using result_t = decltype(f());
+    return state() == result_state::success ? f()
+           : state() == result_state::error
+               ? result_t(error_t, std::move(*this).get_error())
+               : result_t();
+  }
+
+  /**
+   * @brief Invokes the provided function if the result is in a success state,
+   * wrapping its return value in the new result.
+   *
+   * @param f Callable function invoked without arguments if the result is in a
+   * success state.
+   * @return A result holding the value returned by the function, or the
+   * original error.
+   *
+   * @note The provided callable function must have the signature:
+   *       `auto f() -> U`, where U may be void.
+   */
+  template <typename F>
+  constexpr auto map(F&& f) const& {
+    using result_t = result<decltype(f()), E>;
+    if (state() == result_state::success) {
+      if constexpr (std::is_void_v<decltype(f())>) {
+        f();
+        return result_t(success_t);
+      } else {
+        return result_t(success_t, f());
+      }
+    }
+    return state() == result_state::error ? result_t(error_t, get_error())
+                                          : result_t();
+  }
+
+  /**
+   * @brief Rvalue overload of map(), moves the error value into the returned
+   * result.
+   */
+  template <typename F>
+  constexpr auto map(F&& f) && {
+    using result_t = result<decltype(f()), E>;
+    if (state() == result_state::success) {
+      if constexpr (std::is_void_v<decltype(f())>) {
+        f();
+        return result_t(success_t);
+      } else {
+        return result_t(success_t, f());
+      }
+    }
+    return state() == result_state::error
+               ? result_t(error_t, std::move(*this).get_error())
+               : result_t();
+  }
+
+  /**
+   * @brief Maps the error value using the provided function.
+   *
+   * @param f Callable function to be applied to the error value if the result
+   * is in an error state.
+   * @return A new result holding the mapped error value or the original
+   * success.
+   *
+   * @note The provided callable function must have the signature:
+   *       `f(const E& error) -> E`.
+   */
+  template <typename F>
+  constexpr auto map_error(F&& f) const& {
+    return state() == result_state::error
+               ? result<void, E>(error_t, f(get_error()))
+           : state() == result_state::success ? result<void, E>(success_t)
+                                              : result<void, E>();
+  }
+
+  /**
+   * @brief Rvalue overload of map_error(), moves the error value into the
+   * callable function.
+   */
+  template <typename F>
+  constexpr auto map_error(F&& f) && {
+    return state() == result_state::error
+               ? result<void, E>(error_t, f(std::move(*this).get_error()))
+           : state() == result_state::success ? result<void, E>(success_t)
+                                              : result<void, E>();
+  }
+
+  /**
+   * @brief Transforms the result using the provided callable function.
+   *
+   * @param f Callable function to transform the current result.
+   * @return The result of applying the transformation function to the current
+   * result.
+   */
+  template <typename F>
+  constexpr auto transform(F&& f) const&
+      -> result<typename decltype(f(*this))::value_type,
+                typename decltype(f(*this))::error_type> {
+    return f(*this);
+  }
+
+  /**
+   * @brief Rvalue overload of transform(), moves the current result into the
+   * callable function.
+   */
+  template <typename F>
+  constexpr auto transform(F&& f) &&
+      -> result<typename decltype(f(std::move(*this)))::value_type,
+                typename decltype(f(std::move(*this)))::error_type> {
+    return f(std::move(*this));
+  }
+
+  /**
+   * @brief Invokes a callable function on the current result without modifying
+   * it.
+   *
+   * @param f A function that takes a constant reference to the result.
+   * @return A copy of the unmodified current result after invoking the
+   * function.
+   */
+  template <typename F>
+  constexpr result<void, E> inspect(F&& f) const& {
+    f(*this);
+    return *this;
+  }
+
+  /**
+   * @brief Rvalue overload of inspect(), moves the current result into the
+   * returned result after invoking the function.
+   */
+  template <typename F>
+  constexpr result<void, E> inspect(F&& f) && {
+    f(static_cast<const result<void, E>&>(*this));
+    return std::move(*this);
+  }
+
+  /**
+   * @brief Explicit conversion to bool.
+   * @return True if the result is in a success state; otherwise, false.
+   */
+  constexpr explicit operator bool() const {
+    return state() == result_state::success;
+  }
+
+  /**
+   * @brief Converts the result to a result with a different error type.
+   * @tparam U Type of the error value in the new result.
+   * @return A new result with the error value converted to type U.
+   */
+  template <typename U>
+  constexpr operator result<void, U>() const& {
+    return state() == result_state::error ? result<void, U>(error_t,
+                                                            U(get_error()))
+           : state() == result_state::success ? result<void, U>(success_t)
+                                              : result<void, U>();
+  }
+
+  /**
+   * @brief Converts the result to a result with a different error type,
+   * moving the error value into the conversion.
+   * @tparam U Type of the error value in the new result.
+   * @return A new result with the error value converted to type U.
+   */
+  template <typename U>
+  constexpr operator result<void, U>() && {
+    return state() == result_state::error
+               ? result<void, U>(error_t, U(std::move(*this).get_error()))
+           : state() == result_state::success ? result<void, U>(success_t)
+                                              : result<void, U>();
+  }
+
+ private:
+  friend struct detail::result_payload_access;
+  friend struct detail::result_stream_access;
+
+  using base::get_error;
+};
+
+/**
+ * @brief Specialisation of result for a success value that refers to an
+ * existing object. It stores a pointer to the object, so the object is never
+ * copied into the result and must outlive it.
+ *
+ * @tparam T Type of the referred success value.
+ * @tparam E Type of the error value.
+ */
+template <typename T, typename E>
+class result<T&, E> final
+    : private detail::result_base<T*, E>,
+      private detail::result_enable_ctor_base<T*, E>,
+      private detail::result_enable_assign_base<T*, E> {
+  using base = detail::result_base<T*, E>;
+
+ public:
+  using value_type = T&;
+  using error_type = E;
+
+  // Default constructor, creates an empty result
+  constexpr result() = default;
+
+  /**
+   * @brief Constructor for a successful result referring to a value.
+   *
+   * @param value The success value to refer to.
+   */
+  constexpr result(T& value) : base(success_t, detail::address_of(value)) {}
+
+  // A result cannot refer to a temporary.
+  result(const T&&) = delete;
+
+  /**
+   * @brief Constructor for a successful result referring to a value, using a
+   * success tag.
+   *
+   * @param tag The success tag, indicating a successful result.
+   * @param value The success value to refer to.
+   */
+  constexpr result(success_tag tag, T& value)
+      : base(tag, detail::address_of(value)) {}
+
+  /**
+   * @brief Constructor for a failed result with an error value.
+   *
+   * @param error The error value to be stored.
+   */
+  constexpr result(const E& error) : base(error_t, error) {}
+
+  /**
+   * @brief Constructor for a failed result, moving the error in.
+   *
+   * @param error The error value to be moved into the result.
+   */
+  constexpr result(E&& error) : base(error_t, std::move(error)) {}
+
+  /**
+   * @brief Constructor for a failed result from a string literal, when the
+   * error type is constructible from a character array (fst::error_string,
+   * std::string) and the success type is not.
+   *
+   * @tparam N The size of the literal, including the terminating null.
+   * @param literal The literal to construct the error value from.
+   */
+  template <std::size_t N, typename U = E,
+            std::enable_if_t<
+                std::is_constructible_v<U, const char (&)[N]> &&
+                !std::is_constructible_v<T&, const char (&)[N]>>* = nullptr>
+  constexpr result(const char (&literal)[N]) : base(error_t, literal) {}
+
+  /**
+   * @brief Constructor for a failed result with an error value, using an error
+   * tag.
+   *
+   * @param tag The error tag, indicating an error result.
+   * @param error The error value to be stored.
+   */
+  constexpr result(error_tag tag, const E& error) : base(tag, error) {}
+
+  /**
+   * @brief Constructor for a failed result, moving the error in, using an
+   * error tag.
+   *
+   * @param tag The error tag, indicating an error result.
+   * @param error The error value to be moved into the result.
+   */
+  constexpr result(error_tag tag, E&& error) : base(tag, std::move(error)) {}
+
+  /**
+   * @brief Constructor for a failed result, constructing the error in place
+   * from the given arguments.
+   *
+   * @tparam Args The types of the arguments forwarded to E's constructor.
+   * @param args The arguments to construct the error value from.
+   */
+  template <typename... Args,
+            std::enable_if_t<std::is_constructible_v<E, Args...>>* = nullptr>
+  constexpr explicit result(in_place_error_tag, Args&&... args)
+      : base(error_t, std::forward<Args>(args)...) {}
+
+  /**
+   * @brief Makes the result refer to another value.
+   *
+   * @param value The success value to refer to.
+   * @return The reference to the success value.
+   */
+  FST_CONSTEXPR20 T& emplace_value(T& value) {
+    const result_state previous = state();
+    this->destroy_payload();
+    this->construct_value(detail::address_of(value));
+    if (previous != result_state::success)
+      this->notify(lifecycle_event::state_change);
+    return value;
+  }
+
+  /**
+   * @brief Replaces the content of the result with an error value
+   * constructed in place from the given arguments.
+   *
+   * @tparam Args The types of the arguments forwarded to E's constructor.
+   * @param args The arguments to construct the error value from.
+   */
+  template <typename... Args,
+            std::enable_if_t<std::is_constructible_v<E, Args...>>* = nullptr>
+  FST_CONSTEXPR20 void emplace_error(Args&&... args) {
+    const result_state previous = state();
+    this->destroy_payload();
+    this->construct_error(std::forward<Args>(args)...);
+    if (previous != result_state::error)
+      this->notify(lifecycle_event::state_change);
+  }
+
+  /**
+   * @brief Retrieves the referenced success value if the result is in a
+   * success state.
+   * @return A pointer to the referenced value if available, otherwise
+   * nullptr.
+   */
+  [[nodiscard]] constexpr T* success() const {
+    return state() == result_state::success ? get_value() : nullptr;
+  }
+
+  /**
+   * @brief Retrieves the error value if the result is in an error state.
+   * @return An optional containing the error value if available, otherwise
+   * std::nullopt.
+   */
+  [[nodiscard]] constexpr const std::optional<E> error() const& {
+    return state() == result_state::error ? std::optional<E>(get_error())
+                                          : std::nullopt;
+  }
+
+  /**
+   * @brief Moves the error value out if the result is in an error state.
+   * @return An optional containing the error value if available, otherwise
+   * std::nullopt.
+   */
+  [[nodiscard]] constexpr std::optional<E> error() && {
+    return state() == result_state::error
+               ? std::optional<E>(std::move(*this).get_error())
+               : std::nullopt;
+  }
+
+  /**
+   * @brief Retrieves the success value of the result.
+   * @return The reference to success value.
+   * @throw std::bad_result_access if result does not contain a success value.
+   */
+  [[nodiscard]] constexpr T& value() const {
+    if (!FST_LIKELY(state() == result_state::success))
+      detail::throw_bad_result_access(state());
+    return *get_value();
+  }
+
+  /**
+   * @brief Retrieves the success value of the result; otherwise, returns a
+   * default value.
+   * @param default_value The value to return if the result is in an error
+   * state.
+   * @return The success value if available; otherwise, the
+   * specified default value.
+   */
+  [[nodiscard]] constexpr T& value_or(T& default_value) const {
+    return state() == result_state::success ? *get_value() : default_value;
+  }
+
+  /**
+   * @brief Retrieves the success value if the result is in a success state.
+   * @param message A message to include in the exception if the result is in an
+   * error state.
+   * @return A reference to the success value.
+   * @throw bad_result_access If the result is not in a success state,
+   * including the first bad_result_access::max_reason_size characters of the
+   * specified message. It used to be a std::runtime_error, handlers must now
+   * catch bad_result_access or std::exception.
+   */
+  [[nodiscard]] constexpr T& expect(std::string_view message) const {
+    if (!FST_LIKELY(state() == result_state::success))
+      detail::throw_bad_result_access(state(), message);
+    return *get_value();
+  }
+
+  /**
+   * @brief Retrieves the state of the result (success or error).
+   * @return The state of the result.
+   */
+  [[nodiscard]] constexpr result_state state() const {
+    return this->get_state();
+  }
+
+  /**
+   * @brief Checks if the result contains a success value.
+   * @return True if the result is in a success state; otherwise, false.
+   */
+  [[nodiscard]] constexpr bool has_value() const {
+    return state() == result_state::success;
+  }
+
+  /**
+   * @brief Checks if the result contains an error value.
+   * @return True if the result is in an error state; otherwise, false.
+   */
+  [[nodiscard]] constexpr bool has_error() const {
+    return state() == result_state::error;
+  }
+
+  /**
+   * @brief Checks if the result is empty.
+   * @return True if the result is empty; otherwise, false.
+   */
+  [[nodiscard]] constexpr bool is_empty() const {
+    return state() == result_state::empty;
+  }
+
+  /**
+   * @brief Applies the provided function to the error value if the result is
+   * in an error state, returning a new result.
+   *
+   * @param f Callable function to be applied to the error value if the result
+   * is in an error state.
+   * @return The original success result or the result of applying the callable
+   * function to the error value.
+   *
+   * @note The provided callable function must have the signature:
+   *       `auto lambda(const E& error) -> result<T&, U>`.
+   */
+  template <typename F>
+  constexpr auto or_else(F&& f) const&
+      -> result<T&,
+                typename decltype(f(std::declval<const E&>()))::error_type> {
+    using result_t = decltype(f(std::declval<const E&>()));
+    return state() == result_state::error ? f(get_error())
+           : state() == result_state::success
+               ? result_t(success_t, *get_value())
+               : result_t();
+  }
+
+  /**
+   * @brief Rvalue overload of or_else(), moves the error value into the
+   * callable function.
+   */
+  template <typename F>
+  constexpr auto or_else(F&& f) &&
+      -> result<T&, typename decltype(f(std::declval<E>()))::error_type> {
+    using result_t = decltype(f(std::declval<E>()));
+    return state() == result_state::error ? f(std::move(*this).get_error())
+           : state() == result_state::success
+               ? result_t(success_t, *get_value())
+               : result_t();
+  }
+
+  /**
+   * @brief Applies the provided callable function to the referred value if the
+   * result is in a success state, returning a new result.
+   *
+   * @param f Callable function to be applied to the success value if the result
+   * is in a success state.
+   * @return The original error result or the result of applying the callable
+   * function to the success value.
+   *
+   * @note The provided callable function must have the signature:
+   *       `auto func(T& value) -> result<U, E>`.
+   */
+  template <typename F>
+  constexpr auto and_then(F&& f) const&
+      -> result<typename decltype(f(std::declval<T&>()))::value_type, E> {
+    using result_t = decltype(f(std::declval<T&>()));
+    return state() == result_state::success ? f(*get_value())
+           : state() == result_state::error ? result_t(error_t, get_error())
+                                            : result_t();
+  }
+
+  /**
+   * @brief Rvalue overload of and_then(), moves the error value into the
+   * returned result.
+   */
+  template <typename F>
+  constexpr auto and_then(F&& f) &&
+      -> result<typename decltype(f(std::declval<T&>()))::value_type, E> {
+    using result_t = decltype(f(std::declval<T&>()));
+    return state() == result_state::success ? f(*get_value())
+           : state() == result_state::error
+               ? result_t(error_t, std::move(*this).get_error())
+               : result_t();
+  }
+
+  /**
+   * @brief Maps the referred value using the provided function.
+   *
+   * @param f Callable function to be applied to the success value if the result
+   * is in a success state.
+   * @return A new result referring to the value returned by the function, or
+   * holding the original error.
+   *
+   * @note The provided callable function must have the signature:
+   *       `auto f(T& value) -> T&`.
+   */
+  template <typename F>
+  constexpr auto map(F&& f) const& {
+    return state() == result_state::success
+               ? result<T&, E>(success_t, f(*get_value()))
+           : state() == result_state::error
+               ? result<T&, E>(error_t, get_error())
+               : result<T&, E>();
+  }
+
+  /**
+   * @brief Rvalue overload of map(), moves the error value into the returned
+   * result.
+   */
+  template <typename F>
+  constexpr auto map(F&& f) && {
+    return state() == result_state::success
+               ? result<T&, E>(success_t, f(*get_value()))
+           : state() == result_state::error
+               ? result<T&, E>(error_t, std::move(*this).get_error())
+               : result<T&, E>();
+  }
+
+  /**
+   * @brief Maps the error value using the provided function.
+   *
+   * @param f Callable function to be applied to the error value if the result
+   * is in an error state.
+   * @return A new result holding the mapped error value or referring to the
+   * original success value.
+   *
+   * @note The provided callable function must have the signature:
+   *       `f(const E& error) -> E`.
+   */
+  template <typename F>
+  constexpr auto map_error(F&& f) const& {
+    return state() == result_state::error
+               ? result<T&, E>(error_t, f(get_error()))
+           : state() == result_state::success
+               ? result<T&, E>(success_t, *get_value())
+               : result<T&, E>();
+  }
+
+  /**
+   * @brief Rvalue overload of map_error(), moves the error value into the
+   * callable function.
+   */
+  template <typename F>
+  constexpr auto map_error(F&& f) && {
+    return state() == result_state::error
+               ? result<T&, E>(error_t, f(std::move(*this).get_error()))
+           : state() == result_state::success
+               ? result<T&, E>(success_t, *get_value())
+               : result<T&, E>();
+  }
+
+  /**
+   * @brief Transforms the result using the provided callable function.
+   *
+   * @param f Callable function to transform the current result.
+   * @return The result of applying the transformation function to the current
+   * result.
+   */
+  template <typename F>
+  constexpr auto transform(F&& f) const&
+      -> result<typename decltype(f(*this))::value_type,
+                typename decltype(f(*this))::error_type> {
+    return f(*this);
+  }
+
+  /**
+   * @brief Rvalue overload of transform(), moves the current result into the
+   * callable function.
+   */
+  template <typename F>
+  constexpr auto transform(F&& f) &&
+      -> result<typename decltype(f(std::move(*this)))::value_type,
+                typename decltype(f(std::move(*this)))::error_type> {
+    return f(std::move(*this));
+  }
+
+  /**
+   * @brief Invokes a callable function on the current result without modifying
+   * it.
+   *
+   * @param f A function that takes a constant reference to the result.
+   * @return A copy of the unmodified current result after invoking the
+   * function.
+   */
+  template <typename F>
+  constexpr result<T&, E> inspect(F&& f) const& {
+    f(*this);
+    return *this;
+  }
+
+  /**
+   * @brief Rvalue overload of inspect(), moves the current result into the
+   * returned result after invoking the function.
+   */
+  template <typename F>
+  constexpr result<T&, E> inspect(F&& f) && {
+    f(static_cast<const result<T&, E>&>(*this));
+    return std::move(*this);
+  }
+
+  /**
+   * @brief Explicit conversion to bool.
+   * @return True if the result is in a success state; otherwise, false.
+   */
+  constexpr explicit operator bool() const {
+    return state() == result_state::success;
+  }
+
+  /**
+   * @brief Dereference operator.
+   * @return Reference to the success value.
+   * @throw bad_result_access If the result is not in a success state.
+   */
+  constexpr T& operator*() const { return value(); }
+
+  /**
+   * @brief Converts the result to a result holding a copy of the referred
+   * value.
+   * @tparam U Type of the success value in the new result.
+   * @return A new result with the success value converted to type U.
+   */
+  template <typename U>
+  constexpr operator result<U, E>() const& {
+    return state() == result_state::success
+               ? result<U, E>(success_t, U(*get_value()))
+           : state() == result_state::error ? result<U, E>(error_t, get_error())
+                                            : result<U, E>();
+  }
+
+  /**
+   * @brief Converts the result to a result with a different error type.
+   * @tparam U Type of the error value in the new result.
+   * @return A new result with the error value converted to type U.
+   */
+  template <typename U>
+  constexpr operator result<T&, U>() const& {
+    return state() == result_state::error
+               ? result<T&, U>(error_t, U(get_error()))
+           : state() == result_state::success
+               ? result<T&, U>(success_t, *get_value())
+               : result<T&, U>();
+  }
+
+ private:
+  friend struct detail::result_payload_access;
+  friend struct detail::result_stream_access;
+
+  using base::get_error;
+  using base::get_value;
+};
+
+}  // namespace fst
+
+#if defined(FST_NO_EXCEPTIONS)
+#include "fst/result_panic.hpp"
+#endif
+
+#if defined(FST_RESULT_EXTERN_TEMPLATES)
+#include "fst/result_extern.hpp"
+#endif
+
+#endif  // FST_RESULT_CORE_HPP
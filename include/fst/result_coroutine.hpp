@@ -0,0 +1,271 @@
+// result_coroutine.hpp
+#ifndef FST_RESULT_COROUTINE_HPP
+#define FST_RESULT_COROUTINE_HPP
+
+/**
+ * Optional C++20 coroutine integration for result.
+ *
+ * A function returning `fst::result<T, E>` or `fst::result<void, E>` becomes a
+ * coroutine when it uses `co_await` or `co_return`. `co_await` on a result
+ * yields its value, or finishes the coroutine early with the error of the
+ * awaited result, converted to E, or with an empty result:
+ *
+ * @code
+ * fst::result<int, std::string> total(const std::string& a,
+ *                                     const std::string& b) {
+ *   int x = co_await parse(a);
+ *   int y = co_await parse(b);
+ *   co_return x + y;
+ * }
+ * @endcode
+ *
+ * The coroutines run to completion synchronously and their handle never
+ * escapes, which allows a compiler to elide the allocation of the frame.
+ * When the frame is allocated, it comes from a thread-local pool of
+ * fixed-size blocks instead of the global heap.
+ *
+ * The returned result is converted from the promise's return object after
+ * the coroutine body has run. This deferred conversion (CWG2563) has been
+ * verified with GCC 12. Recent Clang releases convert eagerly, before the
+ * body, and a result converted then cannot be completed later: a trivially
+ * copyable result may be returned through a temporary, so not even its
+ * address is known. Any other compiler converting eagerly terminates the
+ * program on the first call instead of returning a wrong result.
+ *
+ * The header is empty unless the compiler supports coroutines and is not
+ * Clang; FST_RESULT_HAS_COROUTINES is defined when it is not empty.
+ */
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>) && \
+    !defined(__clang__)
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "fst/result_core.hpp"
+
+#define FST_RESULT_HAS_COROUTINES 1
+
+namespace fst {
+
+namespace detail {
+
+// Thread-local free lists of coroutine frames, one per 64-byte size class up
+// to 1 KiB. Larger frames use the global heap. Each list keeps at most
+// `max_cached` blocks, blocks freed on another thread join that thread's list.
+class coroutine_frame_pool {
+ public:
+  static constexpr std::size_t granularity = 64;
+  static constexpr std::size_t classes = 16;
+  static constexpr std::size_t max_cached = 64;
+
+  static void* allocate(std::size_t size) {
+    const std::size_t index = class_of(size);
+    if (index >= classes) return ::operator new(size);
+
+    free_lists& lists = local();
+    if (block* head = lists.heads[index]) {
+      lists.heads[index] = head->next;
+      --lists.counts[index];
+      return head;
+    }
+    return ::operator new((index + 1) * granularity);
+  }
+
+  static void deallocate(void* frame, std::size_t size) noexcept {
+    const std::size_t index = class_of(size);
+    if (index >= classes) return ::operator delete(frame);
+
+    free_lists& lists = local();
+    if (lists.counts[index] == max_cached) return ::operator delete(frame);
+    lists.heads[index] = ::new (frame) block{lists.heads[index]};
+    ++lists.counts[index];
+  }
+
+ private:
+  struct block {
+    block* next;
+  };
+
+  struct free_lists {
+    block* heads[classes] = {};
+    std::size_t counts[classes] = {};
+
+    ~free_lists() {
+      for (block* head : heads)
+        while (head) ::operator delete(std::exchange(head, head->next));
+    }
+  };
+
+  static std::size_t class_of(std::size_t size) noexcept {
+    return (size + granularity - 1) / granularity - 1;
+  }
+
+  static free_lists& local() {
+    thread_local free_lists lists;
+    return lists;
+  }
+};
+
+template <typename R, typename Promise>
+class result_awaiter {
+ public:
+  explicit result_awaiter(R&& awaited) noexcept
+      : m_awaited(std::forward<R>(awaited)) {}
+
+  bool await_ready() const noexcept { return m_awaited.has_value(); }
+
+  // Hands the failure to the returned result and finishes the coroutine, the
+  // awaited result is a temporary of the frame so it is read before destroy.
+  void await_suspend(std::coroutine_handle<Promise> handle) {
+    handle.promise().fail(std::forward<R>(m_awaited));
+    handle.destroy();
+  }
+
+  decltype(auto) await_resume() {
+    if constexpr (!std::is_void_v<
+                      typename std::remove_reference_t<R>::value_type>)
+      return *std::forward<R>(m_awaited);
+  }
+
+ private:
+  R&& m_awaited;
+};
+
+template <typename T, typename E>
+class result_promise;
+
+template <typename T, typename E>
+class result_promise_base;
+
+// Object returned by get_return_object(), converted to the result once the
+// coroutine has run. The promise writes the outcome into its storage and is
+// told the new address whenever the object is moved before completion.
+template <typename T, typename E>
+class result_return_object {
+ public:
+  explicit result_return_object(
+      result_promise_base<T, E>& promise) noexcept
+      : m_promise(&promise) {
+    m_promise->m_return = this;
+  }
+
+  result_return_object(result_return_object&& other) noexcept(
+      std::is_nothrow_move_constructible_v<result<T, E>>)
+      : m_storage(std::move(other.m_storage)),
+        m_promise(other.m_promise),
+        m_completed(other.m_completed) {
+    if (!m_completed) m_promise->m_return = this;
+  }
+
+  result_return_object(const result_return_object&) = delete;
+
+  operator result<T, E>() {
+    // Converting before the body has run means the compiler does not defer
+    // the conversion, which this integration requires
+    if (!m_completed) std::terminate();
+    return std::move(m_storage);
+  }
+
+ private:
+  friend class result_promise_base<T, E>;
+
+  result<T, E> m_storage;
+  result_promise_base<T, E>* m_promise;
+  bool m_completed = false;
+};
+
+template <typename T, typename E>
+class result_promise_base {
+ public:
+  result_return_object<T, E> get_return_object() noexcept {
+    return result_return_object<T, E>(*this);
+  }
+
+  std::suspend_never initial_suspend() const noexcept { return {}; }
+  std::suspend_never final_suspend() const noexcept { return {}; }
+
+  void unhandled_exception() {
+#if defined(FST_NO_EXCEPTIONS)
+    std::terminate();
+#else
+    throw;
+#endif
+  }
+
+  template <typename U, typename F>
+  auto await_transform(result<U, F>& awaited) noexcept {
+    return result_awaiter<result<U, F>&, result_promise<T, E>>(awaited);
+  }
+
+  template <typename U, typename F>
+  auto await_transform(const result<U, F>& awaited) noexcept {
+    return result_awaiter<const result<U, F>&, result_promise<T, E>>(awaited);
+  }
+
+  template <typename U, typename F>
+  auto await_transform(result<U, F>&& awaited) noexcept {
+    return result_awaiter<result<U, F>&&, result_promise<T, E>>(
+        std::move(awaited));
+  }
+
+  // Finishes with the error of a failed awaited result, or with an empty
+  // result if the awaited result was empty.
+  template <typename R>
+  void fail(R&& awaited) {
+    static_assert(std::is_constructible_v<
+                      E, typename std::remove_reference_t<R>::error_type>,
+                  "the awaited error type must be convertible to E");
+    set(awaited.has_error()
+            ? result<T, E>(error_t, E(*std::forward<R>(awaited).error()))
+            : result<T, E>());
+  }
+
+  static void* operator new(std::size_t size) {
+    return coroutine_frame_pool::allocate(size);
+  }
+
+  static void operator delete(void* frame, std::size_t size) noexcept {
+    coroutine_frame_pool::deallocate(frame, size);
+  }
+
+ protected:
+  void set(result<T, E>&& outcome) {
+    m_return->m_storage = std::move(outcome);
+    m_return->m_completed = true;
+  }
+
+ private:
+  friend class result_return_object<T, E>;
+
+  result_return_object<T, E>* m_return = nullptr;
+};
+
+template <typename T, typename E>
+class result_promise : public result_promise_base<T, E> {
+ public:
+  void return_value(result<T, E> value) { this->set(std::move(value)); }
+};
+
+template <typename E>
+class result_promise<void, E> : public result_promise_base<void, E> {
+ public:
+  void return_void() { this->set(result<void, E>(success_t)); }
+};
+
+}  // namespace detail
+
+}  // namespace fst
+
+template <typename T, typename E, typename... Args>
+struct std::coroutine_traits<fst::result<T, E>, Args...> {
+  using promise_type = fst::detail::result_promise<T, E>;
+};
+
+#endif  // defined(__cpp_impl_coroutine) && ... && !defined(__clang__)
+
+#endif  // FST_RESULT_COROUTINE_HPP
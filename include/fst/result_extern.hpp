@@ -0,0 +1,28 @@
+// result_extern.hpp
+#ifndef FST_RESULT_EXTERN_HPP
+#define FST_RESULT_EXTERN_HPP
+
+// Explicit instantiation declarations of the common result specialisations.
+// Their members are instantiated once, in the result-cpp-precompiled
+// library, instead of in every translation unit that uses them. This header
+// is included by fst/result_core.hpp when FST_RESULT_EXTERN_TEMPLATES is
+// defined, which linking result-cpp-precompiled does.
+//
+// The library is built with the primary result_lifecycle template, do not
+// combine it with a specialised lifecycle policy.
+
+#include <string>
+
+#include "fst/error_code.hpp"
+#include "fst/result_core.hpp"
+
+namespace fst {
+
+extern template class result<int, std::string>;
+extern template class result<double, std::string>;
+extern template class result<std::string, std::string>;
+extern template class result<void, error_code>;
+
+}  // namespace fst
+
+#endif  // FST_RESULT_EXTERN_HPP
@@ -0,0 +1,19 @@
+// result_fwd.hpp
+#ifndef FST_RESULT_FWD_HPP
+#define FST_RESULT_FWD_HPP
+
+// Declarations of the result types, for headers that only name them in
+// declarations. Include fst/result_core.hpp to use them.
+
+namespace fst {
+
+enum class result_state : unsigned char;
+
+class bad_result_access;
+
+template <typename T, typename E>
+class result;
+
+}  // namespace fst
+
+#endif  // FST_RESULT_FWD_HPP
@@ -0,0 +1,84 @@
+// result_io.hpp
+#ifndef FST_RESULT_IO_HPP
+#define FST_RESULT_IO_HPP
+
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+#include "fst/result_core.hpp"
+
+namespace fst {
+
+namespace detail {
+
+struct result_stream_access {
+  template <typename R>
+  static constexpr decltype(auto) value(const R& res) {
+    return res.get_value();
+  }
+
+  template <typename R>
+  static constexpr decltype(auto) error(const R& res) {
+    return res.get_error();
+  }
+};
+
+}  // namespace detail
+
+/**
+ * @brief Converts a result_state enum to a string.
+ *
+ * @param state The result_state to convert.
+ * @return A string representation of the result_state.
+ */
+inline std::string to_string(const result_state& state) {
+  return detail::state_name(state);
+}
+
+/**
+ * @brief Converts a result_state enum to a string and streams it to an output
+ * stream.
+ *
+ * @param os The output stream to write to.
+ * @param state The result_state to convert and stream.
+ * @return The modified output stream.
+ */
+inline std::ostream& operator<<(std::ostream& os, const result_state& state) {
+  return os << detail::state_name(state);
+}
+
+/**
+ * @brief Streams the success or error value of a result. An empty result, and
+ * the success of a result<void, E>, stream nothing.
+ *
+ * @param os The output stream to write to.
+ * @param res The result to stream.
+ * @return The modified output stream.
+ */
+template <typename T, typename E>
+std::ostream& operator<<(std::ostream& os, const result<T, E>& res) {
+  using access = detail::result_stream_access;
+  switch (res.state()) {
+    case result_state::success:
+      if constexpr (std::is_void_v<T>)
+        return os;
+      else if constexpr (std::is_reference_v<T>)
+        return os << *access::value(res);
+      else
+        return os << access::value(res);
+
+    case result_state::error:
+      return os << access::error(res);
+
+    case result_state::empty:
+      return os;
+
+    default:
+      detail::throw_bad_result_access();
+  }
+}
+
+}  // namespace fst
+
+#endif  // FST_RESULT_IO_HPP
@@ -0,0 +1,67 @@
+// result_panic.hpp
+#ifndef FST_RESULT_PANIC_HPP
+#define FST_RESULT_PANIC_HPP
+
+// The handler called on an invalid access when exceptions are disabled.
+// fst/result_core.hpp includes this header in that case, fst/result.hpp
+// always does, so the handler can be installed in either configuration.
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+
+#include "fst/result_core.hpp"
+
+namespace fst {
+
+/**
+ * @brief Handler called on an invalid access instead of throwing when
+ * exceptions are disabled (see FST_NO_EXCEPTIONS).
+ *
+ * It receives the bad_result_access that would have been thrown and must not
+ * return, std::abort() is called if it does. The default handler writes
+ * what() to stderr and aborts.
+ */
+using panic_handler = void (*)(const bad_result_access&) noexcept;
+
+namespace detail {
+
+[[noreturn]] inline void default_panic_handler(
+    const bad_result_access& error) noexcept {
+  std::fprintf(stderr, "fst::result panic: %s\n", error.what());
+  std::abort();
+}
+
+inline std::atomic<panic_handler> current_panic_handler{
+    &default_panic_handler};
+
+[[noreturn]] inline void panic(const bad_result_access& error) noexcept {
+  current_panic_handler.load()(error);
+  std::abort();
+}
+
+}  // namespace detail
+
+/**
+ * @brief Installs the handler called on an invalid access when exceptions
+ * are disabled.
+ *
+ * @param handler The new handler, nullptr restores the default handler.
+ * @return The previously installed handler.
+ */
+inline panic_handler set_panic_handler(panic_handler handler) noexcept {
+  return detail::current_panic_handler.exchange(
+      handler != nullptr ? handler : &detail::default_panic_handler);
+}
+
+/**
+ * @brief Retrieves the handler called on an invalid access when exceptions
+ * are disabled.
+ */
+inline panic_handler get_panic_handler() noexcept {
+  return detail::current_panic_handler.load();
+}
+
+}  // namespace fst
+
+#endif  // FST_RESULT_PANIC_HPP
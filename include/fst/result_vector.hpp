@@ -0,0 +1,599 @@
+// result_vector.hpp
+#ifndef FST_RESULT_VECTOR_HPP
+#define FST_RESULT_VECTOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "fst/result_core.hpp"
+
+namespace fst {
+
+namespace detail {
+
+// Number of set bits in a bitmap word.
+inline unsigned popcount(std::uint64_t word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<unsigned>(__builtin_popcountll(word));
+#else
+  unsigned count = 0;
+  for (; word != 0; word &= word - 1) ++count;
+  return count;
+#endif
+}
+
+// Index of the lowest set bit of a non-zero bitmap word.
+inline unsigned lowest_set_bit(std::uint64_t word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<unsigned>(__builtin_ctzll(word));
+#else
+  unsigned index = 0;
+  for (; (word & 1) == 0; word >>= 1) ++index;
+  return index;
+#endif
+}
+
+}  // namespace detail
+
+/**
+ * @brief Structure-of-arrays container of results.
+ *
+ * Instead of storing a whole `result<T, E>` per element, a result_vector
+ * keeps:
+ *
+ * - two bitmaps, one bit per element each, recording which elements hold a
+ *   value and which hold an error (neither bit means empty),
+ * - a dense array of values indexed by element, in which only the slots of
+ *   successful elements hold a constructed T,
+ * - a sparse side-table of (index, error) pairs sorted by index.
+ *
+ * When errors are rare the memory used is close to `sizeof(T)` plus 2 bits
+ * per element, and counting or visiting successes scans the bitmap a word at
+ * a time. Elements are accessed through a proxy exposing the result API.
+ *
+ * @tparam T The type of the success values.
+ * @tparam E The type of the error values.
+ */
+template <typename T, typename E>
+class result_vector {
+  static_assert(std::is_object_v<T> && std::is_object_v<E>,
+                "result_vector requires object payload types");
+
+  template <bool Const>
+  class element_ref;
+
+ public:
+  using value_type = result<T, E>;
+  using size_type = std::size_t;
+  using reference = element_ref<false>;
+  using const_reference = element_ref<true>;
+
+  /// Returned by searches when no element matches.
+  static constexpr size_type npos = static_cast<size_type>(-1);
+
+  result_vector() noexcept = default;
+
+  // Delegates to the default constructor so that the destructor releases the
+  // values copied so far if a copy throws.
+  result_vector(const result_vector& other) : result_vector() {
+    m_errors = other.m_errors;
+    reallocate(other.m_size);
+    other.for_each_value([this](size_type index, const T& value) {
+      ::new (m_values + index) T(value);
+      set_bit(m_value_bits, index);
+    });
+    for (const auto& entry : m_errors) set_bit(m_error_bits, entry.first);
+    m_size = other.m_size;
+  }
+
+  result_vector(result_vector&& other) noexcept { swap(other); }
+
+  result_vector& operator=(const result_vector& other) {
+    if (this != &other) {
+      result_vector copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+
+  result_vector& operator=(result_vector&& other) noexcept {
+    if (this != &other) {
+      result_vector moved(std::move(other));
+      swap(moved);
+    }
+    return *this;
+  }
+
+  ~result_vector() {
+    clear();
+    std::allocator<T>().deallocate(m_values, m_capacity);
+  }
+
+  void swap(result_vector& other) noexcept {
+    std::swap(m_value_bits, other.m_value_bits);
+    std::swap(m_error_bits, other.m_error_bits);
+    std::swap(m_values, other.m_values);
+    std::swap(m_size, other.m_size);
+    std::swap(m_capacity, other.m_capacity);
+    std::swap(m_errors, other.m_errors);
+  }
+
+  /**
+   * @brief Returns the number of elements.
+   */
+  size_type size() const noexcept { return m_size; }
+
+  /**
+   * @brief Checks whether the container has no elements.
+   */
+  bool empty() const noexcept { return m_size == 0; }
+
+  /**
+   * @brief Returns the number of elements that fit without reallocating.
+   */
+  size_type capacity() const noexcept { return m_capacity; }
+
+  /**
+   * @brief Reserves room for at least `capacity` elements.
+   */
+  void reserve(size_type capacity) {
+    if (capacity > m_capacity) reallocate(capacity);
+  }
+
+  /**
+   * @brief Removes all elements, keeping the capacity.
+   */
+  void clear() noexcept {
+    for_each_value([](size_type, T& value) { value.~T(); });
+    std::fill(m_value_bits.begin(), m_value_bits.end(), 0);
+    std::fill(m_error_bits.begin(), m_error_bits.end(), 0);
+    m_errors.clear();
+    m_size = 0;
+  }
+
+  /**
+   * @brief Appends a copy of a result.
+   */
+  void push_back(const result<T, E>& res) {
+    if (res.has_value())
+      emplace_value(*res);
+    else if (res.has_error())
+      emplace_error(*res.error());
+    else
+      push_empty();
+  }
+
+  /**
+   * @brief Appends a result, moving its payload in.
+   */
+  void push_back(result<T, E>&& res) {
+    if (res.has_value())
+      emplace_value(*std::move(res));
+    else if (res.has_error())
+      emplace_error(*std::move(res).error());
+    else
+      push_empty();
+  }
+
+  /**
+   * @brief Appends a successful element constructed in place.
+   *
+   * @return Reference to the new value.
+   */
+  template <typename... Args>
+  T& emplace_value(Args&&... args) {
+    grow_for_one();
+    T* value = ::new (m_values + m_size) T(std::forward<Args>(args)...);
+    set_bit(m_value_bits, m_size++);
+    return *value;
+  }
+
+  /**
+   * @brief Appends a failed element whose error is constructed in place.
+   */
+  template <typename... Args>
+  void emplace_error(Args&&... args) {
+    grow_for_one();
+    m_errors.emplace_back(std::piecewise_construct,
+                          std::forward_as_tuple(m_size),
+                          std::forward_as_tuple(std::forward<Args>(args)...));
+    set_bit(m_error_bits, m_size++);
+  }
+
+  /**
+   * @brief Appends an empty element.
+   */
+  void push_empty() {
+    grow_for_one();
+    ++m_size;
+  }
+
+  /**
+   * @brief Removes the last element.
+   */
+  void pop_back() noexcept {
+    reset(m_size - 1);
+    --m_size;
+  }
+
+  /**
+   * @brief Returns a proxy to the element at `index`, without bounds checks.
+   */
+  reference operator[](size_type index) noexcept { return {this, index}; }
+
+  /**
+   * @brief Returns a read-only proxy to the element at `index`, without
+   * bounds checks.
+   */
+  const_reference operator[](size_type index) const noexcept {
+    return {this, index};
+  }
+
+  /**
+   * @brief Returns the state of the element at `index`.
+   */
+  result_state state(size_type index) const noexcept {
+    return test_bit(m_value_bits, index)   ? result_state::success
+           : test_bit(m_error_bits, index) ? result_state::error
+                                           : result_state::empty;
+  }
+
+  /**
+   * @brief Returns the number of successful elements, counted over the
+   * bitmap.
+   */
+  size_type count_values() const noexcept {
+    size_type count = 0;
+    for (std::uint64_t word : m_value_bits) count += detail::popcount(word);
+    return count;
+  }
+
+  /**
+   * @brief Returns the number of failed elements.
+   */
+  size_type count_errors() const noexcept { return m_errors.size(); }
+
+  /**
+   * @brief Returns the index of the first failed element, or npos.
+   */
+  size_type find_first_error() const noexcept {
+    return m_errors.empty() ? npos : m_errors.front().first;
+  }
+
+  /**
+   * @brief Returns the index of the first element that is not successful,
+   * or npos, scanning the bitmap a word at a time.
+   */
+  size_type find_first_not_value() const noexcept {
+    for (size_type w = 0; w * bits_per_word < m_size; ++w) {
+      const std::uint64_t missing = ~m_value_bits[w];
+      if (missing != 0) {
+        const size_type index = w * bits_per_word +
+                                detail::lowest_set_bit(missing);
+        return index < m_size ? index : npos;
+      }
+    }
+    return npos;
+  }
+
+  /**
+   * @brief Calls `f(index, value)` for each successful element in index
+   * order, visiting only the set bits of the bitmap.
+   */
+  template <typename F>
+  void for_each_value(F&& f) {
+    for (size_type w = 0; w < m_value_bits.size(); ++w)
+      for (std::uint64_t word = m_value_bits[w]; word != 0; word &= word - 1) {
+        const size_type index = w * bits_per_word +
+                                detail::lowest_set_bit(word);
+        f(index, m_values[index]);
+      }
+  }
+
+  /**
+   * @brief Const overload of for_each_value().
+   */
+  template <typename F>
+  void for_each_value(F&& f) const {
+    for (size_type w = 0; w < m_value_bits.size(); ++w)
+      for (std::uint64_t word = m_value_bits[w]; word != 0; word &= word - 1) {
+        const size_type index = w * bits_per_word +
+                                detail::lowest_set_bit(word);
+        f(index, static_cast<const T&>(m_values[index]));
+      }
+  }
+
+  /**
+   * @brief Calls `f(index, error)` for each failed element in index order.
+   */
+  template <typename F>
+  void for_each_error(F&& f) const {
+    for (const auto& entry : m_errors) f(entry.first, entry.second);
+  }
+
+ private:
+  static constexpr size_type bits_per_word = 64;
+
+  static bool test_bit(const std::vector<std::uint64_t>& bits,
+                       size_type index) noexcept {
+    return (bits[index / bits_per_word] >> (index % bits_per_word)) & 1;
+  }
+
+  static void set_bit(std::vector<std::uint64_t>& bits,
+                      size_type index) noexcept {
+    bits[index / bits_per_word] |= std::uint64_t(1) << (index % bits_per_word);
+  }
+
+  static void clear_bit(std::vector<std::uint64_t>& bits,
+                        size_type index) noexcept {
+    bits[index / bits_per_word] &=
+        ~(std::uint64_t(1) << (index % bits_per_word));
+  }
+
+  void grow_for_one() {
+    if (m_size == m_capacity)
+      reallocate(m_capacity == 0 ? bits_per_word : m_capacity * 2);
+  }
+
+  // Moves the constructed values into a buffer of `capacity` slots and grows
+  // the bitmaps to match. The old values are only destroyed once all of them
+  // have been transferred, so a throwing copy leaves the vector unchanged.
+  void reallocate(size_type capacity) {
+    const size_type words = (capacity + bits_per_word - 1) / bits_per_word;
+    m_value_bits.resize(words, 0);
+    m_error_bits.resize(words, 0);
+
+    T* values = std::allocator<T>().allocate(capacity);
+    size_type failed = 0;
+    const auto transfer = [this, values, &failed] {
+      for_each_value([values, &failed](size_type index, T& value) {
+        failed = index;
+        ::new (values + index) T(std::move_if_noexcept(value));
+      });
+    };
+#if defined(FST_NO_EXCEPTIONS)
+    transfer();
+#else
+    try {
+      transfer();
+    } catch (...) {
+      for_each_value([values, failed](size_type index, T&) {
+        if (index < failed) values[index].~T();
+      });
+      std::allocator<T>().deallocate(values, capacity);
+      throw;
+    }
+#endif
+    for_each_value([](size_type, T& value) { value.~T(); });
+    std::allocator<T>().deallocate(m_values, m_capacity);
+    m_values = values;
+    m_capacity = capacity;
+  }
+
+  // Index of the side-table entry of `index`, or of the entry it should be
+  // inserted before.
+  typename std::vector<std::pair<size_type, E>>::iterator error_entry(
+      size_type index) noexcept {
+    return std::lower_bound(
+        m_errors.begin(), m_errors.end(), index,
+        [](const auto& entry, size_type i) { return entry.first < i; });
+  }
+
+  typename std::vector<std::pair<size_type, E>>::const_iterator error_entry(
+      size_type index) const noexcept {
+    return std::lower_bound(
+        m_errors.begin(), m_errors.end(), index,
+        [](const auto& entry, size_type i) { return entry.first < i; });
+  }
+
+  // Leaves the element at `index` empty.
+  void reset(size_type index) noexcept {
+    if (test_bit(m_value_bits, index)) {
+      m_values[index].~T();
+      clear_bit(m_value_bits, index);
+    } else if (test_bit(m_error_bits, index)) {
+      m_errors.erase(error_entry(index));
+      clear_bit(m_error_bits, index);
+    }
+  }
+
+  template <typename... Args>
+  void assign_value(size_type index, Args&&... args) {
+    reset(index);
+    ::new (m_values + index) T(std::forward<Args>(args)...);
+    set_bit(m_value_bits, index);
+  }
+
+  template <typename... Args>
+  void assign_error(size_type index, Args&&... args) {
+    if (test_bit(m_error_bits, index)) {
+      error_entry(index)->second = E(std::forward<Args>(args)...);
+      return;
+    }
+    reset(index);
+    m_errors.emplace(error_entry(index), std::piecewise_construct,
+                     std::forward_as_tuple(index),
+                     std::forward_as_tuple(std::forward<Args>(args)...));
+    set_bit(m_error_bits, index);
+  }
+
+  std::vector<std::uint64_t> m_value_bits;
+  std::vector<std::uint64_t> m_error_bits;
+  T* m_values = nullptr;
+  size_type m_size = 0;
+  size_type m_capacity = 0;
+  std::vector<std::pair<size_type, E>> m_errors;
+};
+
+/**
+ * @brief Proxy to an element of a result_vector exposing the result API.
+ *
+ * Accessors read the element in place. Combinators operate on a copy of the
+ * element obtained with `get()`. The mutable proxy can be assigned a result.
+ */
+template <typename T, typename E>
+template <bool Const>
+class result_vector<T, E>::element_ref {
+  using container = std::conditional_t<Const, const result_vector,
+                                       result_vector>;
+  using value_ref = std::conditional_t<Const, const T&, T&>;
+
+ public:
+  element_ref(container* owner, size_type index) noexcept
+      : m_owner(owner), m_index(index) {}
+
+  element_ref(const element_ref&) = default;
+
+  /**
+   * @brief Assigns the referenced element, not the proxy.
+   */
+  const element_ref& operator=(const element_ref& other) const {
+    return *this = other.get();
+  }
+
+  /**
+   * @brief Replaces the element with a copy of a result.
+   */
+  template <bool C = Const, std::enable_if_t<!C>* = nullptr>
+  const element_ref& operator=(const result<T, E>& res) const {
+    if (res.has_value())
+      m_owner->assign_value(m_index, *res);
+    else if (res.has_error())
+      m_owner->assign_error(m_index, *res.error());
+    else
+      m_owner->reset(m_index);
+    return *this;
+  }
+
+  /**
+   * @brief Replaces the element with a result, moving its payload in.
+   */
+  template <bool C = Const, std::enable_if_t<!C>* = nullptr>
+  const element_ref& operator=(result<T, E>&& res) const {
+    if (res.has_value())
+      m_owner->assign_value(m_index, *std::move(res));
+    else if (res.has_error())
+      m_owner->assign_error(m_index, *std::move(res).error());
+    else
+      m_owner->reset(m_index);
+    return *this;
+  }
+
+  /**
+   * @brief Returns the state of the element.
+   */
+  result_state state() const noexcept { return m_owner->state(m_index); }
+
+  [[nodiscard]] bool has_value() const noexcept {
+    return state() == result_state::success;
+  }
+
+  [[nodiscard]] bool has_error() const noexcept {
+    return state() == result_state::error;
+  }
+
+  [[nodiscard]] bool is_empty() const noexcept {
+    return state() == result_state::empty;
+  }
+
+  explicit operator bool() const noexcept { return has_value(); }
+
+  /**
+   * @brief Returns the value of the element in place.
+   *
+   * @throw bad_result_access If the element is not successful.
+   */
+  value_ref value() const {
+    if (!FST_LIKELY(has_value())) detail::throw_bad_result_access(state());
+    return m_owner->m_values[m_index];
+  }
+
+  value_ref operator*() const { return value(); }
+
+  /**
+   * @brief Returns the value of the element or the given default value.
+   */
+  template <typename U>
+  T value_or(U&& default_value) const {
+    return has_value() ? T(m_owner->m_values[m_index])
+                       : T(std::forward<U>(default_value));
+  }
+
+  /**
+   * @brief Returns a copy of the value if the element is successful.
+   */
+  std::optional<T> success() const {
+    return has_value() ? std::optional<T>(m_owner->m_values[m_index])
+                       : std::nullopt;
+  }
+
+  /**
+   * @brief Returns a copy of the error if the element failed.
+   */
+  std::optional<E> error() const {
+    return has_error() ? std::optional<E>(m_owner->error_entry(m_index)->second)
+                       : std::nullopt;
+  }
+
+  /**
+   * @brief Returns a copy of the element as a result.
+   */
+  result<T, E> get() const {
+    switch (state()) {
+      case result_state::success:
+        return result<T, E>(success_t, m_owner->m_values[m_index]);
+      case result_state::error:
+        return result<T, E>(error_t, m_owner->error_entry(m_index)->second);
+      default:
+        return result<T, E>();
+    }
+  }
+
+  operator result<T, E>() const { return get(); }
+
+  template <typename F>
+  auto and_then(F&& f) const {
+    return get().and_then(std::forward<F>(f));
+  }
+
+  template <typename F>
+  auto or_else(F&& f) const {
+    return get().or_else(std::forward<F>(f));
+  }
+
+  template <typename F>
+  auto map(F&& f) const {
+    return get().map(std::forward<F>(f));
+  }
+
+  template <typename F>
+  auto map_error(F&& f) const {
+    return get().map_error(std::forward<F>(f));
+  }
+
+  template <typename F>
+  auto transform(F&& f) const {
+    return get().transform(std::forward<F>(f));
+  }
+
+  // Needs the stream operator of result from fst/result_io.hpp.
+  friend std::ostream& operator<<(std::ostream& os, const element_ref& ref) {
+    return os << ref.get();
+  }
+
+ private:
+  container* m_owner;
+  size_type m_index;
+};
+
+}  // namespace fst
+
+#endif  // FST_RESULT_VECTOR_HPP
@@ -0,0 +1,42 @@
+// result.cppm
+// C++20 module interface of the result API, `import fst.result;` provides
+// the declarations of fst/result.hpp. Built by the result-cpp-module target.
+
+module;
+
+#include "fst/result.hpp"
+
+export module fst.result;
+
+export namespace fst {
+
+using fst::result_state;
+using fst::success_tag;
+using fst::error_tag;
+using fst::empty_tag;
+using fst::in_place_success_tag;
+using fst::in_place_error_tag;
+using fst::success_t;
+using fst::error_t;
+using fst::empty_t;
+using fst::in_place_success;
+using fst::in_place_error;
+
+using fst::lifecycle_event;
+using fst::result_lifecycle;
+
+using fst::bad_result_access;
+
+using fst::panic_handler;
+using fst::set_panic_handler;
+using fst::get_panic_handler;
+
+using fst::niche_traits;
+using fst::enum_niche_traits;
+
+using fst::result;
+
+using fst::to_string;
+using fst::operator<<;
+
+}  // namespace fst
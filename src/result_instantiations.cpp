@@ -0,0 +1,17 @@
+// result_instantiations.cpp
+// Explicit instantiation definitions matching fst/result_extern.hpp, built
+// into the result-cpp-precompiled library.
+
+#include <string>
+
+#include "fst/error_code.hpp"
+#include "fst/result_extern.hpp"
+
+namespace fst {
+
+template class result<int, std::string>;
+template class result<double, std::string>;
+template class result<std::string, std::string>;
+template class result<void, error_code>;
+
+}  // namespace fst